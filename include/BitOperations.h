@@ -8,6 +8,11 @@
 #include <bit>
 #include <cinttypes>
 #include <cstdlib>
+#include <type_traits>
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif // __BMI2__
 
 /*
  *  This header collects some functions used to manipulate bits in a 64-bit unsigned integers.
@@ -67,6 +72,27 @@ constexpr int CountOnesInBoard(const uint64_t bitMap) { return std::popcount(bit
 /* Count same bits */
 constexpr int CountSameBits(const uint64_t a, const uint64_t b) { return std::popcount((a & b) | ((~a) & (~b))); }
 
+/* Function gathers bits of 'x' selected by the 'mask' into the lowest bits of the result (parallel bits extract).
+ * Uses BMI2 PEXT instruction when target supports it, otherwise or at compile time falls back to simple loop. */
+constexpr uint64_t ExtractBitsByMask(const uint64_t x, uint64_t mask)
+{
+#ifdef __BMI2__
+    if (!std::is_constant_evaluated())
+        return _pext_u64(x, mask);
+#endif // __BMI2__
+
+    uint64_t result{};
+    for (uint64_t resultBit = 1; mask != 0; resultBit <<= 1)
+    {
+        if ((x & ExtractLsbBit(mask)) != 0)
+            result |= resultBit;
+
+        mask &= mask - 1;
+    }
+
+    return result;
+}
+
 /*          IMPORTANT NOTES:
  *  Function assumes that containerPos is already set to 1
  *  and container[0] is 0 value, which will induce all others.
@@ -5,10 +5,11 @@
 #ifndef BOARD_H
 #define BOARD_H
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <cinttypes>
-#include <unordered_map>
+#include <type_traits>
 
 #include "BitOperations.h"
 #include "CompilationConstants.h"
@@ -97,6 +98,15 @@ enum CastlingPossibilities : size_t
  *      - Single MovingColor: integer representing color of the player who is currently moving.
  *      - Castlings: bitset representing all castling possibilities for both colors with one additional sentinel field
  * at the end.
+ *      - PieceOnSquare: mailbox storing index of the bitboard containing the figure placed on given field (indexed by
+ * msb position) or SentinelBoardIndex when the field is empty. Kept in sync with BitBoards to answer "what stands on
+ * this field" queries without scanning all the bitboards.
+ *      - ZobristKey, PawnKey, MaterialKey: hashes of the whole position, the pawn structure and the material signature,
+ * updated incrementally on every move, so no hash has to be recomputed or passed along with the board.
+ *      - PsqtMidgame, PsqtEndgame, PhaseWeights: piece-square table sums and the game phase weights of all figures,
+ * updated incrementally on every move in the same way, refer to PieceSquareTables.
+ *      - RepetitionKeys: ring buffer of hashes of all positions played so far, indexed by the ply. Used to detect
+ * repetitions without any allocations, keeping the board trivially copyable.
  *
  * */
 
@@ -127,8 +137,46 @@ struct Board
 
     constexpr uint64_t GetFigBoard(int col, size_t figDesc) const { return BitBoards[col * BitBoardsPerCol + figDesc]; }
 
+    [[nodiscard]] INLINE size_t GetPieceOnSquare(const int msbPos) const { return PieceOnSquare[msbPos]; }
+
+    /* Rebuilds the mailbox from the bitboards, must be used after any direct modification of the bitboards */
+    void RecomputePieceOnSquare()
+    {
+        PieceOnSquare.fill(SentinelBoardIndex);
+
+        for (size_t ind = 0; ind < BitBoardsCount; ++ind)
+            for (uint64_t figs = BitBoards[ind]; figs; figs ^= ExtractLsbBit(figs))
+                PieceOnSquare[ExtractMsbPos(ExtractLsbBit(figs))] = static_cast<uint8_t>(ind);
+    }
+
     [[nodiscard]] bool IsEndGame() const { return LastPhase < END_GAME_PHASE; }
 
+    INLINE void PushRepetitionKey(const uint64_t hash)
+    {
+        RepetitionKeys[RepetitionKeysCount++ & RepetitionKeysMask] = hash;
+    }
+
+    INLINE void PopRepetitionKey() { --RepetitionKeysCount; }
+
+    /* Drops the whole history, used after irreversible moves, as previous positions are unreachable */
+    void ResetRepetitionKeys(const uint64_t hash)
+    {
+        RepetitionKeysCount = 0;
+        PushRepetitionKey(hash);
+    }
+
+    /* Counts occurrences of the position with given hash, including the current one. Only positions with the same side
+     * to move played after the last irreversible move are scanned */
+    [[nodiscard]] INLINE int CountRepetitions(const uint64_t hash) const
+    {
+        const int last  = RepetitionKeysCount - 1;
+        const int first = std::max({0, last - HalfMoves, last - static_cast<int>(RepetitionKeysCapacity) + 1});
+
+        int count{};
+        for (int ply = last; ply >= first; ply -= 2) count += RepetitionKeys[ply & RepetitionKeysMask] == hash;
+        return count;
+    }
+
     // ------------------------------
     // Class fields
     // ------------------------------
@@ -143,6 +191,8 @@ struct Board
     static constexpr uint64_t InvalidElPassantBitBoard = MaxMsbPossible >> InvalidElPassantField;
     static constexpr size_t SentinelBoardIndex         = 12;
     static constexpr size_t SentinelCastlingIndex      = 4;
+    static constexpr size_t RepetitionKeysCapacity     = 1024; // must be a power of two
+    static constexpr size_t RepetitionKeysMask         = RepetitionKeysCapacity - 1;
 
     static constexpr std::array<uint64_t, KingPosCount> DefaultKingBoards{
         MaxMsbPossible >> ConvertToReversedPos(4), MaxMsbPossible >> ConvertToReversedPos(60)
@@ -178,13 +228,39 @@ struct Board
     int MovingColor                                    = WHITE;
     std::array<uint64_t, BitBoardsCount + 1> BitBoards = {}; // additional sentinel board
 
+    // mailbox indexed by msb position, every field is empty by default
+    std::array<uint8_t, BitBoardFields> PieceOnSquare = []
+    {
+        std::array<uint8_t, BitBoardFields> mailbox{};
+        mailbox.fill(SentinelBoardIndex);
+        return mailbox;
+    }();
+
+    // --------------------------------
+    // Incrementally updated hashes
+    // --------------------------------
+
+    uint64_t ZobristKey  = {};
+    uint64_t PawnKey     = {};
+    uint64_t MaterialKey = {};
+
+    // --------------------------------------
+    // Incrementally updated evaluation terms
+    // --------------------------------------
+
+    int32_t PsqtMidgame  = {}; // white minus black, not tapered
+    int32_t PsqtEndgame  = {};
+    int32_t PhaseWeights = {}; // not scaled, refer to BoardEvaluator for scaling
+
     // --------------------------------------
     // Draw and state monitoring fields
     // --------------------------------------
 
-    int HalfMoves                                 = {};
-    uint16_t Age                                  = {}; // stores total half moves since the beginning of the game
-    std::unordered_map<uint64_t, int> Repetitions = {}; // Stores hashes of previous encountered positions
+    int HalfMoves = {};
+    uint16_t Age  = {}; // stores total half moves since the beginning of the game
+
+    std::array<uint64_t, RepetitionKeysCapacity> RepetitionKeys = {}; // hashes of previously encountered positions
+    int RepetitionKeysCount                                      = {}; // total number of keys pushed, top of the ring
 
     // ------------------------------
     // Optimisation components
@@ -193,4 +269,6 @@ struct Board
     int LastPhase = {}; // Field used to save previously calculated phase during evaluation
 };
 
+static_assert(std::is_trivially_copyable_v<Board>, "Board must be trivially copyable");
+
 #endif // BOARD_H
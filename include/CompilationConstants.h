@@ -12,17 +12,27 @@
 using lli                  = long long int;
 static constexpr size_t MB = 1024 * 1024;
 
-// global defined Stack capacity used to store generated moves per thread
-static constexpr size_t DEFAULT_STACK_SIZE = 32 * MB / sizeof(uint64_t);
-
 /* Defines maximal depth of search allowed across the project */
 static constexpr int MAX_SEARCH_DEPTH = 128;
 
+/* Upper bound of legal moves in any chess position (218 is the known maximum) */
+static constexpr size_t MAX_MOVES_PER_POSITION = 256;
+
+/* Upper bound of nodes keeping their moves on the stack at once: search plies with extensions and quiesce plies.
+ * Measured paths stay below 30 plies and below 400 stored moves, so the bound leaves a wide margin. */
+static constexpr size_t MAX_STACK_PLY = 4 * MAX_SEARCH_DEPTH;
+
+// global defined Stack capacity used to store generated moves per thread, memory is committed only on use
+static constexpr size_t DEFAULT_STACK_SIZE = MAX_STACK_PLY * MAX_MOVES_PER_POSITION;
+
 /* Defines granularity of score returned by the static evaluation function */
 static constexpr int SCORE_GRAIN = 4;
 
 static constexpr uint64_t MSEC_TO_NSEC = 1000 * 1000;
 
+/* Number of nodes visited by a searcher between its checks of the search deadline, must be a power of two */
+static constexpr uint64_t TIME_CHECK_NODE_INTERVAL = 1024;
+
 static constexpr int16_t DRAW_SCORE         = 0;
 static constexpr int16_t SPECIAL_DRAW_SCORE = 0;
 
@@ -52,8 +62,18 @@ static constexpr int NEGATIVE_INFINITY               = std::numeric_limits<int16
 static constexpr int POSITIVE_INFINITY               = std::numeric_limits<int16_t>::max() - RESERVED_SCORE_VALUES;
 static constexpr int BEST_MATE_VALUE                 = NEGATIVE_INFINITY + MAX_SEARCH_DEPTH;
 static constexpr int BEST_MATE_VALUE_ABS             = -(BEST_MATE_VALUE);
-static constexpr uint16_t QUIESENCE_AGE_DIFF_REPLACE = 16;
-static constexpr uint16_t DEFAULT_AGE_DIFF_REPLACE   = 10;
+
+// weight of single search generation when choosing TT entry to replace, compared against entry depth
+static constexpr int TT_AGE_REPLACE_WEIGHT = 8;
+
+/* Number of entries of the per-thread pawn structure hash table (64 bytes each), must be a power of two */
+static constexpr size_t PAWN_HASH_TABLE_SIZE = 16384;
+
+/* Number of entries of the per-thread material signature hash table (24 bytes each), must be a power of two */
+static constexpr size_t MATERIAL_HASH_TABLE_SIZE = 4096;
+
+/* Default size in MB of the per-thread static evaluation cache (8 bytes per entry), 0 disables the cache */
+static constexpr size_t EVAL_CACHE_DEFAULT_SIZE_MB = 1;
 
 // average pawn value + some part of average pawn
 static constexpr int DELTA_PRUNING_SAFETY_MARGIN = (115 + 115) / SCORE_GRAIN;
@@ -182,6 +202,37 @@ static constexpr bool TestAsp = false;
 
 //---------------------------
 
+// ------------------------------
+// Controls whether sliding figure moves are read from PEXT indexed maps instead of fancy magic ones.
+// PEXT requires BMI2 instruction set, so maps are used only when the target architecture supports it.
+
+#if defined(USE_PEXT_MAPS) && defined(__BMI2__)
+
+static constexpr bool UsePextMaps = true;
+
+#else
+
+static constexpr bool UsePextMaps = false;
+
+#endif // USE_PEXT_MAPS && __BMI2__
+
+//---------------------------
+
+// ------------------------------
+// Controls whether the first ply of the quiescence search also searches quiet moves giving check
+
+#ifdef USE_QSEARCH_CHECKS
+
+static constexpr bool UseQSearchChecks = true;
+
+#else
+
+static constexpr bool UseQSearchChecks = false;
+
+#endif // USE_QSEARCH_CHECKS
+
+//---------------------------
+
 // --------------------------
 // Trace extension changes
 
@@ -5,6 +5,7 @@
 #ifndef ENGINE_H
 #define ENGINE_H
 
+#include <algorithm>
 #include <chrono>
 #include <map>
 #include <memory>
@@ -14,6 +15,7 @@
 #include "Interface/FenTranslator.h"
 #include "Interface/Logger.h"
 #include "Interface/UCIOptions.h"
+#include "MoveGeneration/PerftTable.h"
 #include "OpeningBook/OpeningBook.h"
 
 /*
@@ -45,10 +47,11 @@ class Engine
     /*
      * Returns map of moves and their leaf counts its mean number of leafs at the full search tree base - Used for tests
      * only. Keys are simply uci encoded moves, values are the number of leafs at the end of the search tree.
+     * Root moves are split across all engine threads, perft hash is used when enabled.
      * */
     std::map<std::string, uint64_t> GetPerft(int depth);
 
-    /* Simple wrapper of 'GetPerft' to pretty print the results */
+    /* Simple wrapper of 'GetPerft' to pretty print the results together with nodes per second */
     template <bool LogToOut = true> double GoPerft(int depth);
 
     /* Tries to parse given position and applies it to internal boards */
@@ -66,6 +69,9 @@ class Engine
     /* Restarts the engine up to initial state, sets up the default board and cleans up the Transposition Table */
     void RestartEngine();
 
+    /* Blocks until all work started in the background (e.g. Transposition Table clearing) is finished */
+    void WaitForBackgroundTasks();
+
     /* Simply copies the board */
     [[nodiscard]] Board GetUnderlyingBoardCopy() const;
 
@@ -105,7 +111,7 @@ class Engine
     private:
     /* Method simply generates moves and checks whether given moves is on the list if that's true applies the move to
      * the board */
-    bool _applyMove(Board &board, const std::string &move, uint64_t &hash);
+    bool _applyMove(Board &board, const std::string &move);
 
     // ------------------------------------
     // UCI option accessing functions
@@ -113,20 +119,29 @@ class Engine
 
     static void _changeOrSetLogFile(Engine &eng, std::string &nPath);
 
-    static void _changeHashSize([[maybe_unused]] Engine &, lli size);
+    static void _changeHashSize(Engine &eng, lli size);
 
     static void _changeBookUsage(Engine &eng, bool newValue);
 
-    static void _clearHash([[maybe_unused]] Engine &);
+    static void _clearHash(Engine &eng);
 
     static void _changeDebugEnginePath(Engine &, std::string &path);
 
     static void _changeBookPath(Engine &engine, std::string &path);
 
-    static void _changeThreadCount([[maybe_unused]] Engine &eng, const lli tCount)
-    {
-        GlobalLogger.LogStream << "New thread count: " << tCount << '\n';
-    }
+    static void _changeThreadCount(Engine &eng, lli tCount);
+
+    static void _changeHashFilePath(Engine &eng, std::string &path);
+
+    static void _saveHashToFile(Engine &eng);
+
+    static void _loadHashFromFile(Engine &eng);
+
+    static void _changeTTStatistics(Engine &eng, bool enabled);
+
+    static void _changePerftHashSize(Engine &eng, lli size);
+
+    static void _changeEvalCacheSize(Engine &eng, lli size);
 
     // ------------------------------
     // private fields
@@ -136,6 +151,7 @@ class Engine
     Board _board;
     Board _startingBoard;
     OpeningBook _book{};
+    PerftTable _perftTable{};
     std::string _bookPath = _defaultBookPath;
 
     bool _isStartPosPlayed                            = true;
@@ -161,11 +177,15 @@ class Engine
 
     lli _threadCount = 1;
     std::string _debugPath;
+    std::string _hashFilePath = _defaultHashFilePath;
 
-    static constexpr const char *_defaultBookPath = "uci_ready_long";
+    static constexpr const char *_defaultBookPath     = "uci_ready_long";
+    static constexpr const char *_defaultHashFilePath = "hash.tt";
 
     // Options available in engine
-    inline static const OptionT<Option::OptionType::spin> Threads{"Threads", _changeThreadCount, 1, 1024, 1};
+    inline static const OptionT<Option::OptionType::spin> Threads{
+        "Threads", _changeThreadCount, 1, SearchThreadManager::MaxSearchThreads, 1
+    };
     inline static const OptionT<Option::OptionType::string> DebugLogFile{"Debug Log File", _changeOrSetLogFile, ""};
     inline static const OptionT<Option::OptionType::spin> HashSize{"Hash", _changeHashSize, 16, 524289, 16};
     inline static const OptionT<Option::OptionType::check> OwnBook{"OwnBook", _changeBookUsage, true};
@@ -174,6 +194,18 @@ class Engine
         "Test Engine Path", _changeDebugEnginePath, ""
     };
     inline static const OptionT<Option::OptionType::string> BookPath{"OwnBook Path", _changeBookPath, _defaultBookPath};
+    inline static const OptionT<Option::OptionType::string> HashFile{
+        "Hash File", _changeHashFilePath, _defaultHashFilePath
+    };
+    inline static const OptionT<Option::OptionType::button> SaveHash{"Save Hash to File", _saveHashToFile};
+    inline static const OptionT<Option::OptionType::button> LoadHash{"Load Hash from File", _loadHashFromFile};
+    inline static const OptionT<Option::OptionType::check> TTStatistics{"Hash Statistics", _changeTTStatistics, false};
+    inline static const OptionT<Option::OptionType::spin> PerftHashSize{
+        "Perft Hash", _changePerftHashSize, 0, 65536, 0
+    };
+    inline static const OptionT<Option::OptionType::spin> EvalCacheSize{
+        "Eval Cache", _changeEvalCacheSize, 0, 1024, EVAL_CACHE_DEFAULT_SIZE_MB
+    };
 
     inline static const EngineInfo engineInfo = {
         .author = "Jakub Lisowski, Lukasz Kryczka, Jakub Pietrzak Warsaw University of Technology",
@@ -187,6 +219,12 @@ class Engine
                                                   std::make_pair<std::string, const Option *>("Clear Hash", &ClearHash),
                                                   std::make_pair<std::string, const Option *>("Test Engine Path", &TestEnginePath),
                                                   std::make_pair<std::string, const Option *>("OwnBook Path", &BookPath),
+                                                  std::make_pair<std::string, const Option *>("Hash File", &HashFile),
+                                                  std::make_pair<std::string, const Option *>("Save Hash to File", &SaveHash),
+                                                  std::make_pair<std::string, const Option *>("Load Hash from File", &LoadHash),
+                                                  std::make_pair<std::string, const Option *>("Hash Statistics", &TTStatistics),
+                                                  std::make_pair<std::string, const Option *>("Perft Hash", &PerftHashSize),
+                                                  std::make_pair<std::string, const Option *>("Eval Cache", &EvalCacheSize),
                                                   },
     };
 };
@@ -207,7 +245,10 @@ template <bool LogToOut> double Engine::GoPerft(const int depth)
 
     double spentTime = static_cast<double>((t2 - t1).count()) * 1e-6;
     if constexpr (LogToOut)
-        GlobalLogger.LogStream << std::format("Calculated moves: {} in time: {}ms\n", totalSum, spentTime);
+        GlobalLogger.LogStream << std::format(
+            "Calculated moves: {} in time: {}ms nps: {}\n", totalSum, spentTime,
+            static_cast<uint64_t>(static_cast<double>(totalSum) * 1000.0 / std::max(spentTime, 1e-3))
+        );
 
     return spentTime;
 }
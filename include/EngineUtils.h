@@ -9,6 +9,7 @@
 #include <climits>
 #include <cstdint>
 #include <numeric>
+#include <string>
 #include <unordered_map>
 
 #include "Board.h"
@@ -39,6 +40,32 @@ constexpr uint64_t FilterMoves(uint64_t moves, uint64_t allowedMoves) { return m
 void *AlignedAlloc(size_t alignment, size_t size);
 void AlignedFree(void *ptr);
 
+// ------------------------------
+// Functions below allocate big memory chunks backed by huge pages whenever it is possible to reduce TLB misses.
+// On linux explicit 1GB or 2MB huge pages are tried first, then transparent huge pages are requested with madvise.
+// When none of them is available memory silently falls back to the default pages.
+
+struct LargePageAllocation
+{
+    void *ptr{};
+    size_t size{};
+    size_t pageSize{};
+    bool isTransparent{};
+};
+
+LargePageAllocation LargePageAlloc(size_t size);
+void LargePageFree(const LargePageAllocation &allocation);
+
+/* Returns human-readable description of the pages used by the allocation e.g. "2MB huge" */
+std::string GetPageSizeStr(const LargePageAllocation &allocation);
+
+// ------------------------------
+// Functions below only reserve the address space, physical pages are committed by the system on the first touch.
+// Intended for per thread buffers sized for the worst case, which in practice use only a small prefix of it.
+
+void *LazyCommitAlloc(size_t size);
+void LazyCommitFree(void *ptr, size_t size);
+
 // ------------------------------
 
 /* Function simply prints given uint64_t as 8x8 block of 'x' chars when there is positive bit */
@@ -5,10 +5,15 @@
 #ifndef BOARDEVALUATOR_H
 #define BOARDEVALUATOR_H
 
+#include <type_traits>
+
 #include "../Board.h"
 #include "../MoveGeneration/ChessMechanics.h"
 #include "BoardEvaluatorPrinter.h"
 #include "KingSafetyEval.h"
+#include "MaterialHashTable.h"
+#include "PawnHashTable.h"
+#include "PieceSquareTables.h"
 #include "StructureEvaluator.h"
 
 #include "../MoveGeneration/FileMap.h"
@@ -113,14 +118,48 @@ class BoardEvaluator
     // Wrapper used to run chosen evaluation function
     [[nodiscard]] static INLINE int32_t DefaultFullEvalFunction(Board &bd, const int color)
     {
-        const int whiteEval = Evaluation2<EvalMode::BaseMode>(bd);
+        return DefaultFullEvalFunction(bd, color, ChessMechanics{bd}.GetPositionInfo());
+    }
+
+    // Same as above, but reuses occupancy and pins already collected for the node,
+    // pawn structure and material evaluations are taken from the tables when those are passed
+    [[nodiscard]] static INLINE int32_t DefaultFullEvalFunction(
+        Board &bd, const int color, const PositionInfo &info, PawnHashTable *pawnTable = nullptr,
+        MaterialHashTable *materialTable = nullptr
+    )
+    {
+        const int whiteEval = Evaluation2<EvalMode::BaseMode>(bd, info, pawnTable, materialTable);
         return (color == WHITE ? whiteEval : -whiteEval) / SCORE_GRAIN;
     }
 
     template <EvalMode mode = EvalMode::BaseMode> [[nodiscard]] static INLINE int32_t Evaluation2(Board &bd)
     {
-        const auto [isSuccess, counts] = _countFigures(bd);
-        const int32_t phase            = _calcPhase(counts);
+        return Evaluation2<mode>(bd, ChessMechanics{bd}.GetPositionInfo());
+    }
+
+    template <EvalMode mode = EvalMode::BaseMode>
+    [[nodiscard]] static INLINE int32_t Evaluation2(
+        Board &bd, const PositionInfo &info, PawnHashTable *pawnTable = nullptr,
+        MaterialHashTable *materialTable = nullptr
+    )
+    {
+        // material depends on the figure counts only, so it is reused from the table when possible
+        MaterialHashTable::Entry localEntry{};
+        const MaterialHashTable::Entry *material = &localEntry;
+
+        if (mode == EvalMode::PrintMode || materialTable == nullptr)
+            _evaluateMaterial(bd, localEntry);
+        else
+        {
+            const auto [entry, isHit] = materialTable->Probe(bd.MaterialKey);
+
+            if (!isHit)
+                _evaluateMaterial(bd, *entry);
+
+            material = entry;
+        }
+
+        const int32_t phase = _scalePhase(bd.PhaseWeights);
 
         // save phase for later usage
         bd.LastPhase = phase;
@@ -128,18 +167,27 @@ class BoardEvaluator
         if constexpr (mode == EvalMode::PrintMode)
             BoardEvaluatorPrinter::setPhase<mode>(phase);
 
-        const int32_t materialEval =
-            isSuccess ? _materialTable[_getMaterialBoardIndex(counts)] : _slowMaterialCalculation<mode>(counts, phase);
-
         // Avoid positional evaluation on material constellations that are enforced draws
-        if (materialEval == EVAL_DRAW_RESERVED_VALUE)
+        if (material->IsDraw)
             return DRAW_SCORE;
 
-        const int32_t positionEval = _evaluateFields<mode>(bd, phase);
+        // Known endgames are scored by the dedicated functions only
+        if (material->Endgame != nullptr)
+        {
+            const int32_t endgameEval = material->Endgame(bd);
+
+            if constexpr (mode == EvalMode::PrintMode)
+                BoardEvaluatorPrinter::setAdditionalPoints<mode>(std::format("Known endgame: {}\n", endgameEval));
+
+            return endgameEval;
+        }
+
+        const int32_t materialEval = material->MaterialEval;
+        const int32_t positionEval = _evaluateFields<mode>(bd, phase, info, pawnTable);
 
         // only to print bonuses
         if constexpr (mode == EvalMode::PrintMode)
-            _slowMaterialCalculation<mode>(counts, phase);
+            _slowMaterialCalculation<mode>(_countFigures(bd).second, phase);
 
         if constexpr (mode == EvalMode::PrintMode)
         {
@@ -152,9 +200,7 @@ class BoardEvaluator
 
     [[nodiscard]] static INLINE int32_t InterpGameStage(const Board &bd, int32_t midVal, int32_t endVal)
     {
-        const auto [isSuccess, counts] = _countFigures(bd);
-        const int32_t phase            = _calcPhase(counts);
-        return _getTapperedValue(phase, midVal, endVal);
+        return _getTapperedValue(_scalePhase(bd.PhaseWeights), midVal, endVal);
     }
 
     /// \brief Function returns material value per player for a given board
@@ -167,21 +213,14 @@ class BoardEvaluator
         int32_t whiteMaterial = 0;
         for (size_t i = pawnsIndex; i < kingIndex; i++)
         {
-            whiteMaterial += CountOnesInBoard(bd.BitBoards[i]) * FigurePhases[i];
-            blackMaterial += CountOnesInBoard(bd.BitBoards[i + bPawnsIndex]) * FigurePhases[i];
+            whiteMaterial += CountOnesInBoard(bd.BitBoards[i]) * PieceSquareTables::FigurePhases[i];
+            blackMaterial += CountOnesInBoard(bd.BitBoards[i + bPawnsIndex]) * PieceSquareTables::FigurePhases[i];
         }
         return {whiteMaterial, blackMaterial};
     }
 
     /* Function calculates phase of the given board and saves the results inside LastPhase field */
-    static void PopulateLastPhase(Board &bd)
-    {
-        const auto [isSuccess, counts] = _countFigures(bd);
-        const int32_t phase            = _calcPhase(counts);
-
-        // save phase for later usage
-        bd.LastPhase = phase;
-    }
+    static void PopulateLastPhase(Board &bd) { bd.LastPhase = _scalePhase(bd.PhaseWeights); }
 
     // ------------------------------
     // Private class methods
@@ -213,6 +252,18 @@ class BoardEvaluator
         return {overflows == 0, rv};
     }
 
+    // Function fills the entry with the evaluation depending on the figure counts only
+    static void _evaluateMaterial(const Board &bd, MaterialHashTable::Entry &entry)
+    {
+        const auto [isSuccess, counts] = _countFigures(bd);
+        const int32_t materialEval     = isSuccess ? _materialTable[_getMaterialBoardIndex(counts)]
+                                                   : _slowMaterialCalculation(counts, _scalePhase(bd.PhaseWeights));
+
+        entry.Endgame      = EndgameEvaluator::GetEvaluator(bd);
+        entry.MaterialEval = materialEval;
+        entry.IsDraw       = materialEval == EVAL_DRAW_RESERVED_VALUE;
+    }
+
     // Function calculates material table index based on passed figure counts
     static INLINE size_t _getMaterialBoardIndex(const FigureCountsArrayT &counts)
     {
@@ -227,17 +278,25 @@ class BoardEvaluator
     template <EvalMode mode = EvalMode::BaseMode>
     static int32_t _slowMaterialCalculation(const FigureCountsArrayT &figArr, int32_t actPhase);
 
-    // Function calculates game phase based on passed figure counts
+    // Function calculates game phase based on passed figure counts, used only to precompute the material table,
+    // evaluation of the board takes the phase from incrementally updated Board::PhaseWeights
     static INLINE int32_t _calcPhase(const FigureCountsArrayT &figArr)
     {
         int32_t actPhase{};
 
         // calculating game phase
         for (size_t j = 0; j < kingIndex; ++j)
-            actPhase += static_cast<int32_t>(figArr[j] + figArr[BlackFigStartIndex + j]) * FigurePhases[j];
-        actPhase = (actPhase * MaxTaperedCoef + (FullPhase / 2)) / FullPhase; // Always round up (+0.5)
+            actPhase +=
+                static_cast<int32_t>(figArr[j] + figArr[BlackFigStartIndex + j]) * PieceSquareTables::FigurePhases[j];
+
+        return _scalePhase(actPhase);
+    }
 
-        return actPhase;
+    // Function scales summed figure phase weights into [0, MaxTaperedCoef] range
+    static INLINE int32_t _scalePhase(const int32_t phaseWeights)
+    {
+        // Always round up (+0.5)
+        return (phaseWeights * MaxTaperedCoef + (PieceSquareTables::FullPhase / 2)) / PieceSquareTables::FullPhase;
     }
 
     // Function calculates interpolated game value between mig-game and endgame value based on the game phase
@@ -247,12 +306,20 @@ class BoardEvaluator
     }
 
     // Function evaluates pawns on the board, based on position and structures, returns values for both colors
-    // In short is simple wrapper that runs _processPawnEval for both colors and aggregate results
+    // In short is simple wrapper that takes the pawn structure from the table (or computes it on a miss)
+    // and runs _processPawnEval for both colors to aggregate results
+    template <EvalMode mode = EvalMode::BaseMode>
+    static _fieldEvalInfo_t _evaluatePawns(
+        Board &bd, uint64_t blackPinnedFigs, uint64_t whitePinnedFigs, uint64_t fullMap, PawnHashTable *pawnTable
+    );
+
+    // Function fills the entry with the evaluation depending on pawns only, that is the structure of both colors,
+    // passed pawns, pawn attacks and attack spans
     template <EvalMode mode = EvalMode::BaseMode>
-    static _fieldEvalInfo_t
-    _evaluatePawns(Board &bd, uint64_t blackPinnedFigs, uint64_t whitePinnedFigs, uint64_t fullMap);
+    static void _evaluatePawnStructure(const Board &bd, PawnHashTable::Entry &entry);
 
-    // Function iterates through all pawns on given color and evaluates them based on position and structures
+    // Function iterates through all pawns on given color and evaluates their structure, returns the eval and map of
+    // passed pawns.
     // MapT - map that defines pawn moves and board indexes
     // fieldValueAccess - function used to transform msbPos to
     //                      index in field->value table is used to flip one board to others board values
@@ -261,14 +328,20 @@ class BoardEvaluator
     //  - isolated pawns
     //  - passed pawns
     template <EvalMode mode, class MapT, int (*fieldValueAccess)(int msbPos)>
-    static evalResult _processPawnEval(Board &bd, uint64_t pinnedFigs, uint64_t fullMap);
+    static std::pair<int32_t, uint64_t> _processPawnStructure(const Board &bd);
+
+    // Function evaluates pawns of given color in terms not depending on pawns only: pins, pawn chains based on legal
+    // pawn attacks and king ring attacks. pawnAttacks - attacks of all pawns of the color taken from the pawn table
+    template <EvalMode mode, class MapT>
+    static evalResult _processPawnEval(Board &bd, uint64_t pinnedFigs, uint64_t fullMap, uint64_t pawnAttacks);
 
     // Function performs king position evaluation
     template <EvalMode mode = EvalMode::BaseMode> static void _evaluateKings(Board &bd, _fieldEvalInfo_t &io);
 
     // Function performs positional evaluation of the whole board, simply iterates through all figure types and append
     // the results to the output. Output is tapered based on given phase.
-    template <EvalMode mode = EvalMode::BaseMode> static int32_t _evaluateFields(Board &bd, int32_t phase);
+    template <EvalMode mode = EvalMode::BaseMode>
+    static int32_t _evaluateFields(Board &bd, int32_t phase, const PositionInfo &info, PawnHashTable *pawnTable);
 
     // Function takes as a template argument Map of given figure and one of belows function that is used to evaluate
     // specific figure on both colors and append the result to given out object.
@@ -463,7 +536,8 @@ class BoardEvaluator
         325,   // Bishop
         500,   // Rook
         975,   // Queen
-        10000  // king
+        10000, // king
+        0      // sentinel - nothing is killed by quiet moves
     };
 
     // values that are used to calculate material value of given board at the end-game stage
@@ -475,105 +549,9 @@ class BoardEvaluator
         1000, // Queen
     };
 
-    // Weights below are usd to calculate game phase based on the number of figures on the board
-    static constexpr int16_t PawnPhase   = 0;
-    static constexpr int16_t KnightPhase = 1;
-    static constexpr int16_t BishopPhase = 1;
-    static constexpr int16_t RookPhase   = 2;
-    static constexpr int16_t QueenPhase  = 4;
-
-    static constexpr int16_t FigurePhases[] = {PawnPhase, KnightPhase, BishopPhase, RookPhase, QueenPhase};
-
-    // Full phase based on available figure counts
-    static constexpr int16_t FullPhase = 4 * KnightPhase + 4 * BishopPhase + 4 * RookPhase + 2 * QueenPhase;
-
     // Maximal value to which the phase can be scaled
     static constexpr int16_t MaxTaperedCoef = 256;
 
-    // ----------------------------------------------
-    // Figure-Position bonuses/penalties tables
-    // ----------------------------------------------
-
-    // IMPORTANT: PREVENTS FROM REMOVING BOARD FORMAT
-    // clang-format off
-    static constexpr int16_t BasicBlackPawnPositionValues[]{
-         0,  0,   0,   0,   0,   0,  0,  0,
-        40, 40,  40,  40,  40,  40, 40, 40,
-        30, 30,  30,  30,  30,  30, 30, 30,
-        20, 20,  20,  20,  20,  20, 20, 20,
-        10, 10,  10,  10,  10,  10, 10, 10,
-         5,  5,   5,   5,   5,   5,  5,  5,
-         0,  0,   0,   0,   0,   0,  0,  0,
-         0,  0,   0,   0,   0,   0,  0,  0
-    };
-
-    static constexpr int16_t BasicBlackPawnPositionEndValues[]{
-         0,  0,   0,   0,   0,   0,  0,  0,
-        80, 80,  80,  80,  80,  80, 80, 80,
-        60, 60,  60,  60,  60,  60, 60, 60,
-        40, 40,  40,  40,  40,  40, 40, 40,
-        20, 20,  20,  20,  20,  20, 20, 20,
-        10, 10,  10,  10,  10,  10, 10, 10,
-         0,  0,   0,   0,   0,   0,  0,  0,
-         0,  0,   0,   0,   0,   0,  0,  0
-    };
-
-    static constexpr int16_t BasicBlackKnightPositionValues[]{
-        -50,-40,-30,-30,-30,-30,-40,-50,
-        -40,-20,  0,  0,  0,  0,-20,-40,
-        -30,  0, 10, 15, 15, 10,  0,-30,
-        -30,  5, 15, 20, 20, 15,  5,-30,
-        -30,  0, 15, 20, 20, 15,  0,-30,
-        -30,  5, 10, 15, 15, 10,  5,-30,
-        -40,-20,  0,  5,  5,  0,-20,-40,
-        -50,-40,-30,-30,-30,-30,-40,-50,
-    };
-
-    static constexpr int16_t BasicBlackBishopPositionValues[]{
-        -20, -10, -10, -10, -10, -10, -10, -20,
-        -10,   0,   0,   0,   0,   0,   0, -10,
-        -10,   0,   5,  10,  10,   5,   0, -10,
-        -10,   5,   5,  10,  10,   5,   5, -10,
-        -10,   0,  10,  10,  10,  10,   0, -10,
-        -10,  10,  10,  10,  10,  10,  10, -10,
-        -10,   5,   0,   0,   0,   0,   5, -10,
-        -20, -10, -10, -10, -10, -10, -10, -20,
-    };
-
-    static constexpr int16_t BasicBlackQueenPositionValues[]{
-        -20,-10,-10, -5, -5,-10,-10,-20,
-        -10,  0,  0,  0,  0,  0,  0,-10,
-        -10,  0,  5,  5,  5,  5,  0,-10,
-         -5,  0,  5,  5,  5,  5,  0, -5,
-          0,  0,  5,  5,  5,  5,  0, -5,
-        -10,  5,  5,  5,  5,  5,  0,-10,
-        -10,  0,  5,  0,  0,  0,  0,-10,
-        -20,-10,-10, -5, -5,-10,-10,-20
-    };
-
-    static constexpr int16_t BasicBlackKingPositionValues[]{
-        -30, -40, -40, -50, -50, -40, -40, -30,
-        -30, -40, -40, -50, -50, -40, -40, -30,
-        -30, -40, -40, -50, -50, -40, -40, -30,
-        -30, -40, -40, -50, -50, -40, -40, -30,
-        -20, -30, -30, -40, -40, -30, -30, -20,
-        -10, -20, -20, -20, -20, -20, -20, -10,
-         20,  20,   0,   0,   0,   0,  20,  20,
-         20,  30,  10,   0,   0,  10,  30,  20
-    };
-
-    static constexpr int16_t BasicBlackKingEndPositionValues[]{
-        -50, -40, -30, -20, -20, -30, -40, -50,
-        -30, -20, -10,   0,   0, -10, -20, -30,
-        -30, -10,  20,  30,  30,  20, -10, -30,
-        -30, -10,  30,  40,  40,  30, -10, -30,
-        -30, -10,  30,  40,  40,  30, -10, -30,
-        -30, -10,  20,  30,  30,  20, -10, -30,
-        -30, -30,   0,   0,   0,   0, -30, -30,
-        -50, -30, -30, -30, -30, -30, -30, -50
-    };
-    // clang-format on
-
     // ------------------------------
     // Material table
     // ------------------------------
@@ -627,14 +605,14 @@ BoardEvaluator::evalResult BoardEvaluator::_processKnightEval<mode, MapT, fieldV
         // adding penalty for being pinned
         interEval += TrappedPiecePenalty;
 
-        // adding positional field values
-        const int positionalValuesMid = BasicBlackKnightPositionValues[fieldValueAccess(msbPos)];
-        interEval += positionalValuesMid;
-
+        // positional field values are accumulated inside the board, only printing them here
         if constexpr (mode == EvalMode::PrintMode)
+        {
+            const int positionalValuesMid = PieceSquareTables::BasicBlackKnightPositionValues[fieldValueAccess(msbPos)];
             BoardEvaluatorPrinter::setValueOfPiecePositionTappered<mode>(
                 ConvertToReversedPos(msbPos), positionalValuesMid, positionalValuesMid
             );
+        }
 
         if constexpr (mode == EvalMode::PrintMode)
             BoardEvaluatorPrinter::setPenaltyAndBonuses<mode>(ConvertToReversedPos(msbPos), TrappedPiecePenalty);
@@ -660,14 +638,14 @@ BoardEvaluator::evalResult BoardEvaluator::_processKnightEval<mode, MapT, fieldV
         midEval += mobilityBonusMid;
         endEval += mobilityBonusEnd;
 
-        // adding positional field values
-        const int positionalValuesMid = BasicBlackKnightPositionValues[fieldValueAccess(msbPos)];
-        interEval += positionalValuesMid;
-
+        // positional field values are accumulated inside the board, only printing them here
         if constexpr (mode == EvalMode::PrintMode)
+        {
+            const int positionalValuesMid = PieceSquareTables::BasicBlackKnightPositionValues[fieldValueAccess(msbPos)];
             BoardEvaluatorPrinter::setValueOfPiecePositionTappered<mode>(
                 ConvertToReversedPos(msbPos), positionalValuesMid, positionalValuesMid
             );
+        }
 
         if constexpr (mode == EvalMode::PrintMode)
             BoardEvaluatorPrinter::setMobilityBonusTappered<mode>(
@@ -724,14 +702,14 @@ BoardEvaluator::evalResult BoardEvaluator::_processBishopEval<mode, MapT, fieldV
         if constexpr (mode == EvalMode::PrintMode)
             BoardEvaluatorPrinter::setPenaltyAndBonuses<mode>(ConvertToReversedPos(msbPos), trappedPoints);
 
-        // adding positional field values
-        const int positionalValuesMid = BasicBlackBishopPositionValues[fieldValueAccess(msbPos)];
-        interEval += positionalValuesMid;
-
+        // positional field values are accumulated inside the board, only printing them here
         if constexpr (mode == EvalMode::PrintMode)
+        {
+            const int positionalValuesMid = PieceSquareTables::BasicBlackBishopPositionValues[fieldValueAccess(msbPos)];
             BoardEvaluatorPrinter::setValueOfPiecePositionTappered<mode>(
                 ConvertToReversedPos(msbPos), positionalValuesMid, positionalValuesMid
             );
+        }
 
         // adding controlled fields
         controlledFields |= LegalMoves;
@@ -774,14 +752,14 @@ BoardEvaluator::evalResult BoardEvaluator::_processBishopEval<mode, MapT, fieldV
                 ConvertToReversedPos(msbPos), mobilityBonusMid, mobilityBonusEnd
             );
 
-        // adding positional field values
-        const int positionalValuesMid = BasicBlackBishopPositionValues[fieldValueAccess(msbPos)];
-        interEval += positionalValuesMid;
-
+        // positional field values are accumulated inside the board, only printing them here
         if constexpr (mode == EvalMode::PrintMode)
+        {
+            const int positionalValuesMid = PieceSquareTables::BasicBlackBishopPositionValues[fieldValueAccess(msbPos)];
             BoardEvaluatorPrinter::setValueOfPiecePositionTappered<mode>(
                 ConvertToReversedPos(msbPos), positionalValuesMid, positionalValuesMid
             );
+        }
 
         // adding king attack info
         KingSafetyEval::UpdateKingAttacks<mode>(kInfo, moves, kingRing, KingSafetyEval::KingMinorPieceAttackPoints);
@@ -945,14 +923,14 @@ BoardEvaluator::evalResult BoardEvaluator::_processQueenEval<mode, MapT, fieldVa
                 ConvertToReversedPos(msbPos), mobilityBonusMid, mobilityBonusEnd
             );
 
-        // adding positional field values
-        const int positionalValuesMid = BasicBlackQueenPositionValues[fieldValueAccess(msbPos)];
-        midEval += positionalValuesMid;
-
+        // positional field values are accumulated inside the board, only printing them here
         if constexpr (mode == EvalMode::PrintMode)
+        {
+            const int positionalValuesMid = PieceSquareTables::BasicBlackQueenPositionValues[fieldValueAccess(msbPos)];
             BoardEvaluatorPrinter::setValueOfPiecePositionTappered<mode>(
                 ConvertToReversedPos(msbPos), positionalValuesMid, positionalValuesMid
             );
+        }
 
         RemovePiece(pinnedQueens, figMap);
     }
@@ -980,14 +958,14 @@ BoardEvaluator::evalResult BoardEvaluator::_processQueenEval<mode, MapT, fieldVa
                 ConvertToReversedPos(msbPos), mobilityBonusMid, mobilityBonusEnd
             );
 
-        // adding positional field values
-        const int positionalValuesMid = BasicBlackQueenPositionValues[fieldValueAccess(msbPos)];
-        midEval += positionalValuesMid;
-
+        // positional field values are accumulated inside the board, only printing them here
         if constexpr (mode == EvalMode::PrintMode)
+        {
+            const int positionalValuesMid = PieceSquareTables::BasicBlackQueenPositionValues[fieldValueAccess(msbPos)];
             BoardEvaluatorPrinter::setValueOfPiecePositionTappered<mode>(
                 ConvertToReversedPos(msbPos), positionalValuesMid, positionalValuesMid
             );
+        }
 
         // adding king attack info
         KingSafetyEval::UpdateKingAttacks<mode>(kInfo, moves, kingRing, KingSafetyEval::KingQueenAttackPoints);
@@ -1000,23 +978,19 @@ BoardEvaluator::evalResult BoardEvaluator::_processQueenEval<mode, MapT, fieldVa
 
 template <EvalMode mode> void BoardEvaluator::_evaluateKings(Board &bd, BoardEvaluator::_fieldEvalInfo_t &io)
 {
-    const int32_t whiteKingMid = BasicBlackKingPositionValues[ExtractMsbPos(bd.BitBoards[wKingIndex])];
-    const int32_t blackKingMid =
-        BasicBlackKingPositionValues[ConvertToReversedPos(ExtractMsbPos(bd.BitBoards[bKingIndex]))];
-    const int32_t whiteKingEnd = BasicBlackKingEndPositionValues[ExtractMsbPos(bd.BitBoards[wKingIndex])];
-    const int32_t blackKingEnd =
-        BasicBlackKingEndPositionValues[ConvertToReversedPos(ExtractMsbPos(bd.BitBoards[bKingIndex]))];
-
-    io.midgameEval += whiteKingMid - blackKingMid;
-    io.endgameEval += whiteKingEnd - blackKingEnd;
-
+    // king field values are accumulated inside the board, only printing them here
     if constexpr (mode == EvalMode::PrintMode)
     {
+        const int wKingPos = ExtractMsbPos(bd.BitBoards[wKingIndex]);
+        const int bKingPos = ExtractMsbPos(bd.BitBoards[bKingIndex]);
+
         BoardEvaluatorPrinter::setValueOfPiecePositionTappered<mode>(
-            ExtractMsbPos(bd.BitBoards[wKingIndex]), whiteKingMid, whiteKingEnd
+            wKingPos, PieceSquareTables::BasicBlackKingPositionValues[wKingPos],
+            PieceSquareTables::BasicBlackKingEndPositionValues[wKingPos]
         );
         BoardEvaluatorPrinter::setValueOfPiecePositionTappered<mode>(
-            ExtractMsbPos(bd.BitBoards[bKingIndex]), -blackKingMid, -blackKingEnd
+            bKingPos, -PieceSquareTables::BasicBlackKingPositionValues[ConvertToReversedPos(bKingPos)],
+            -PieceSquareTables::BasicBlackKingEndPositionValues[ConvertToReversedPos(bKingPos)]
         );
     }
 
@@ -1033,19 +1007,36 @@ template <EvalMode mode> void BoardEvaluator::_evaluateKings(Board &bd, BoardEva
 }
 
 template <EvalMode mode>
-BoardEvaluator::_fieldEvalInfo_t
-BoardEvaluator::_evaluatePawns(Board &bd, uint64_t blackPinnedFigs, uint64_t whitePinnedFigs, uint64_t fullMap)
+BoardEvaluator::_fieldEvalInfo_t BoardEvaluator::_evaluatePawns(
+    Board &bd, uint64_t blackPinnedFigs, uint64_t whitePinnedFigs, uint64_t fullMap, PawnHashTable *pawnTable
+)
 {
     _fieldEvalInfo_t rv{};
 
+    // print mode always recomputes the structure to display values of every pawn
+    PawnHashTable::Entry localEntry{};
+    const PawnHashTable::Entry *structure = &localEntry;
+
+    if (mode == EvalMode::PrintMode || pawnTable == nullptr)
+        _evaluatePawnStructure<mode>(bd, localEntry);
+    else
+    {
+        const auto [entry, isHit] = pawnTable->Probe(bd.PawnKey);
+
+        if (!isHit)
+            _evaluatePawnStructure<mode>(bd, *entry);
+
+        structure = entry;
+    }
+
     const auto [whiteMidEval, whiteEndEval, whiteControlledFields, whiteKingInfo] =
-        _processPawnEval<mode, WhitePawnMap, NoOp>(bd, whitePinnedFigs, fullMap);
+        _processPawnEval<mode, WhitePawnMap>(bd, whitePinnedFigs, fullMap, structure->PawnAttacks[WHITE]);
 
     const auto [blackMidEval, blackEndEval, blackControlledFields, blackKingInfo] =
-        _processPawnEval<mode, BlackPawnMap, ConvertToReversedPos>(bd, blackPinnedFigs, fullMap);
+        _processPawnEval<mode, BlackPawnMap>(bd, blackPinnedFigs, fullMap, structure->PawnAttacks[BLACK]);
 
-    rv.midgameEval           = whiteMidEval - blackMidEval;
-    rv.endgameEval           = whiteEndEval - blackEndEval;
+    rv.midgameEval           = structure->MidgameEval + whiteMidEval - blackMidEval;
+    rv.endgameEval           = structure->EndgameEval + whiteEndEval - blackEndEval;
     rv.whiteControlledFields = whiteControlledFields;
     rv.blackControlledFields = blackControlledFields;
     rv.whiteKingSafety       = whiteKingInfo;
@@ -1054,173 +1045,177 @@ BoardEvaluator::_evaluatePawns(Board &bd, uint64_t blackPinnedFigs, uint64_t whi
     return rv;
 }
 
-template <EvalMode mode, class MapT, int (*fieldValueAccess)(int msbPos)>
-BoardEvaluator::evalResult
-BoardEvaluator::_processPawnEval(Board &bd, const uint64_t pinnedFigs, const uint64_t fullMap)
+template <EvalMode mode> void BoardEvaluator::_evaluatePawnStructure(const Board &bd, PawnHashTable::Entry &entry)
 {
-    int32_t midEval{};
-    int32_t interEval{};
-    int32_t endEval{};
-    uint64_t pawnControlledFields{};
-    _kingSafetyInfo_t kInfo{};
+    const auto [whiteEval, whitePassedPawns] = _processPawnStructure<mode, WhitePawnMap, NoOp>(bd);
+    const auto [blackEval, blackPassedPawns] = _processPawnStructure<mode, BlackPawnMap, ConvertToReversedPos>(bd);
 
-    uint64_t pinnedPawns   = bd.BitBoards[MapT::GetBoardIndex(0)] & pinnedFigs;
-    uint64_t unpinnedPawns = bd.BitBoards[MapT::GetBoardIndex(0)] ^ pinnedPawns;
+    // structure terms are not tapered for now
+    entry.MidgameEval = whiteEval - blackEval;
+    entry.EndgameEval = whiteEval - blackEval;
 
-    // generating king ring
-    const uint64_t kingRing = KingSafetyEval::GetSafetyFields(bd, SwapColor(MapT::GetColor()));
+    entry.PassedPawns[WHITE] = whitePassedPawns;
+    entry.PassedPawns[BLACK] = blackPassedPawns;
 
-    while (pinnedPawns)
-    {
-        const int msbPos      = ExtractMsbPos(pinnedPawns);
-        const uint64_t figMap = ConvertMsbPosToBitMap(msbPos);
+    entry.PawnAttacks[WHITE] = WhitePawnMap::GetAttackFields(bd.BitBoards[wPawnsIndex]);
+    entry.PawnAttacks[BLACK] = BlackPawnMap::GetAttackFields(bd.BitBoards[bPawnsIndex]);
 
-        ChessMechanics mech{bd};
-        const uint64_t allowedTiles = mech.GenerateAllowedTilesForPrecisedPinnedFig(figMap, fullMap);
-        const uint64_t plainMoves   = FilterMoves(MapT::GetPlainMoves(figMap, fullMap), allowedTiles);
+    entry.AttackSpans[WHITE] = StructureEvaluator::GetAttackSpan(entry.PawnAttacks[WHITE], WHITE);
+    entry.AttackSpans[BLACK] = StructureEvaluator::GetAttackSpan(entry.PawnAttacks[BLACK], BLACK);
+}
 
-        // adding penalty for pinned pawn
-        const int pinnedPawnPenaltyPoints = (plainMoves == 0) * PinnedPawnPenalty;
-        interEval += pinnedPawnPenaltyPoints;
+template <EvalMode mode, class MapT, int (*fieldValueAccess)(int msbPos)>
+std::pair<int32_t, uint64_t> BoardEvaluator::_processPawnStructure(const Board &bd)
+{
+    int32_t eval{};
+    uint64_t passedPawns{};
 
-        if constexpr (mode == EvalMode::PrintMode)
-            BoardEvaluatorPrinter::setPenaltyAndBonuses<mode>(ConvertToReversedPos(msbPos), pinnedPawnPenaltyPoints);
+    const uint64_t allyPawns  = bd.BitBoards[MapT::GetBoardIndex(0)];
+    const uint64_t enemyPawns = bd.BitBoards[MapT::GetEnemyPawnBoardIndex()];
 
-        // adding legal pawn control zone to global
-        pawnControlledFields |= FilterMoves(MapT::GetAttackFields(figMap), allowedTiles);
+    uint64_t pawns = allyPawns;
+    while (pawns)
+    {
+        const int msbPos      = ExtractMsbPos(pawns);
+        const uint64_t figMap = ConvertMsbPosToBitMap(msbPos);
+
+        // field values are accumulated inside the board, only printing them here
+        if constexpr (mode == EvalMode::PrintMode)
+        {
+            const int positionalValueMid = PieceSquareTables::BasicBlackPawnPositionValues[fieldValueAccess(msbPos)];
+            const int positionalValueEnd = PieceSquareTables::BasicBlackPawnPositionEndValues[fieldValueAccess(msbPos)];
+            BoardEvaluatorPrinter::setValueOfPiecePositionTappered<mode>(
+                ConvertToReversedPos(msbPos), positionalValueMid, positionalValueEnd
+            );
+        }
 
         // adding doubled pawn penalty
-        const int doublePawnPoints =
-            StructureEvaluator::EvalDoubledPawn<mode>(bd.BitBoards[MapT::GetBoardIndex(0)], msbPos, MapT::GetColor());
-        interEval += doublePawnPoints;
+        const int doublePawnPoints = StructureEvaluator::EvalDoubledPawn<mode>(allyPawns, msbPos, MapT::GetColor());
+        eval += doublePawnPoints;
 
         if constexpr (mode == EvalMode::PrintMode)
             BoardEvaluatorPrinter::setPenaltyAndBonuses<mode>(ConvertToReversedPos(msbPos), doublePawnPoints);
 
         // adding isolated pawn penalty
-        const int isolatedPawnPoints =
-            StructureEvaluator::EvalIsolatedPawn<mode>(bd.BitBoards[MapT::GetBoardIndex(0)], msbPos);
-        interEval += isolatedPawnPoints;
+        const int isolatedPawnPoints = StructureEvaluator::EvalIsolatedPawn<mode>(allyPawns, msbPos);
+        eval += isolatedPawnPoints;
 
         if constexpr (mode == EvalMode::PrintMode)
             BoardEvaluatorPrinter::setPenaltyAndBonuses<mode>(ConvertToReversedPos(msbPos), isolatedPawnPoints);
 
-        // adding passed pawn penalty
-        const int passedPawnPoints = StructureEvaluator::SimplePassedPawn<mode>(
-            bd.BitBoards[MapT::GetEnemyPawnBoardIndex()], msbPos, MapT::GetColor()
-        );
-        interEval += passedPawnPoints;
+        // adding passed pawn bonus
+        const int passedPawnPoints = StructureEvaluator::SimplePassedPawn<mode>(enemyPawns, msbPos, MapT::GetColor());
+        eval += passedPawnPoints;
+        passedPawns |= passedPawnPoints != 0 ? figMap : 0;
 
         if constexpr (mode == EvalMode::PrintMode)
             BoardEvaluatorPrinter::setPenaltyAndBonuses<mode>(ConvertToReversedPos(msbPos), passedPawnPoints);
 
-        // adding field values
-        const int positionalValueMid = BasicBlackPawnPositionValues[fieldValueAccess(msbPos)];
-        const int positionalValueEnd = BasicBlackPawnPositionEndValues[fieldValueAccess(msbPos)];
-        midEval += positionalValueMid;
-        endEval += positionalValueEnd;
+        RemovePiece(pawns, figMap);
+    }
 
-        if constexpr (mode == EvalMode::PrintMode)
-            BoardEvaluatorPrinter::setValueOfPiecePositionTappered<mode>(
-                ConvertToReversedPos(msbPos), positionalValueMid, positionalValueEnd
-            );
+    return {eval, passedPawns};
+}
 
-        RemovePiece(pinnedPawns, figMap);
-    }
+template <EvalMode mode, class MapT>
+BoardEvaluator::evalResult BoardEvaluator::_processPawnEval(
+    Board &bd, const uint64_t pinnedFigs, const uint64_t fullMap, const uint64_t pawnAttacks
+)
+{
+    // pawn of one color attacks given field when the pawn of the other color would attack the pawn from that field
+    using EnemyMapT = std::conditional_t<MapT::GetColor() == WHITE, BlackPawnMap, WhitePawnMap>;
 
-    // adding controlled fields
-    pawnControlledFields |= MapT::GetAttackFields(unpinnedPawns);
+    int32_t eval{};
+    _kingSafetyInfo_t kInfo{};
 
-    const int chainPoints =
-        StructureEvaluator::EvalPawnChain<mode>(bd.BitBoards[MapT::GetBoardIndex(0)], pawnControlledFields);
-    interEval += chainPoints;
+    const uint64_t allyPawns     = bd.BitBoards[MapT::GetBoardIndex(0)];
+    uint64_t pinnedPawns         = allyPawns & pinnedFigs;
+    const uint64_t unpinnedPawns = allyPawns ^ pinnedPawns;
 
-    if constexpr (mode == EvalMode::PrintMode)
-        BoardEvaluatorPrinter::setAdditionalPoints<mode>(std::format(
-            "{} Pawn chain structure: {}\n", (MapT::GetColor() == WHITE ? "White" : "Black"),
-            (MapT::GetColor() == WHITE ? chainPoints : -chainPoints)
-        ));
+    // pinned pawns control only the fields allowed by the pin, so the attacks of all pawns can not be used then
+    uint64_t pawnControlledFields = pinnedPawns == 0 ? pawnAttacks : MapT::GetAttackFields(unpinnedPawns);
 
-    while (unpinnedPawns)
+    while (pinnedPawns)
     {
-        const int msbPos      = ExtractMsbPos(unpinnedPawns);
+        const int msbPos      = ExtractMsbPos(pinnedPawns);
         const uint64_t figMap = ConvertMsbPosToBitMap(msbPos);
 
-        const uint64_t attackFields = MapT::GetAttackFields(figMap);
-
-        KingSafetyEval::UpdateKingAttacks<mode>(
-            kInfo, attackFields, kingRing, KingSafetyEval::KingMinorPieceAttackPoints
-        );
+        ChessMechanics mech{bd};
+        const uint64_t allowedTiles = mech.GenerateAllowedTilesForPrecisedPinnedFig(figMap, fullMap);
+        const uint64_t plainMoves   = FilterMoves(MapT::GetPlainMoves(figMap, fullMap), allowedTiles);
 
-        // adding field values
-        const int positionalValueMid = BasicBlackPawnPositionValues[fieldValueAccess(msbPos)];
-        const int positionalValueEnd = BasicBlackPawnPositionEndValues[fieldValueAccess(msbPos)];
-        midEval += positionalValueMid;
-        endEval += positionalValueEnd;
+        // adding penalty for pinned pawn
+        const int pinnedPawnPenaltyPoints = (plainMoves == 0) * PinnedPawnPenalty;
+        eval += pinnedPawnPenaltyPoints;
 
         if constexpr (mode == EvalMode::PrintMode)
-            BoardEvaluatorPrinter::setValueOfPiecePositionTappered<mode>(
-                ConvertToReversedPos(msbPos), positionalValueMid, positionalValueEnd
-            );
+            BoardEvaluatorPrinter::setPenaltyAndBonuses<mode>(ConvertToReversedPos(msbPos), pinnedPawnPenaltyPoints);
 
-        // adding doubled pawn penalty
-        const int doublePawnPoints =
-            StructureEvaluator::EvalDoubledPawn<mode>(bd.BitBoards[MapT::GetBoardIndex(0)], msbPos, MapT::GetColor());
-        interEval += doublePawnPoints;
+        // adding legal pawn control zone to global
+        pawnControlledFields |= FilterMoves(MapT::GetAttackFields(figMap), allowedTiles);
 
-        if constexpr (mode == EvalMode::PrintMode)
-            BoardEvaluatorPrinter::setPenaltyAndBonuses<mode>(ConvertToReversedPos(msbPos), doublePawnPoints);
+        RemovePiece(pinnedPawns, figMap);
+    }
 
-        // adding isolated pawn penalty
-        const int isolatedPawnPoints =
-            StructureEvaluator::EvalIsolatedPawn<mode>(bd.BitBoards[MapT::GetBoardIndex(0)], msbPos);
-        interEval += isolatedPawnPoints;
+    const int chainPoints = StructureEvaluator::EvalPawnChain<mode>(allyPawns, pawnControlledFields);
+    eval += chainPoints;
 
-        if constexpr (mode == EvalMode::PrintMode)
-            BoardEvaluatorPrinter::setPenaltyAndBonuses<mode>(ConvertToReversedPos(msbPos), isolatedPawnPoints);
+    if constexpr (mode == EvalMode::PrintMode)
+        BoardEvaluatorPrinter::setAdditionalPoints<mode>(std::format(
+            "{} Pawn chain structure: {}\n", (MapT::GetColor() == WHITE ? "White" : "Black"),
+            (MapT::GetColor() == WHITE ? chainPoints : -chainPoints)
+        ));
 
-        // adding passed pawn penalty
-        const int passedPawnPoints = StructureEvaluator::SimplePassedPawn<mode>(
-            bd.BitBoards[MapT::GetEnemyPawnBoardIndex()], msbPos, MapT::GetColor()
-        );
-        interEval += passedPawnPoints;
+    // only unpinned pawns standing next to the enemy king ring are able to attack it
+    const uint64_t kingRing = KingSafetyEval::GetSafetyFields(bd, SwapColor(MapT::GetColor()));
+    uint64_t ringAttackers  = unpinnedPawns & EnemyMapT::GetAttackFields(kingRing);
 
-        if constexpr (mode == EvalMode::PrintMode)
-            BoardEvaluatorPrinter::setPenaltyAndBonuses<mode>(ConvertToReversedPos(msbPos), passedPawnPoints);
+    while (ringAttackers)
+    {
+        const int msbPos      = ExtractMsbPos(ringAttackers);
+        const uint64_t figMap = ConvertMsbPosToBitMap(msbPos);
 
-        RemovePiece(unpinnedPawns, figMap);
-    }
+        KingSafetyEval::UpdateKingAttacks<mode>(
+            kInfo, MapT::GetAttackFields(figMap), kingRing, KingSafetyEval::KingMinorPieceAttackPoints
+        );
 
-    midEval += interEval;
-    endEval += interEval;
+        RemovePiece(ringAttackers, figMap);
+    }
 
-    return {midEval, endEval, pawnControlledFields, kInfo};
+    return {eval, eval, pawnControlledFields, kInfo};
 }
 
-template <EvalMode mode> int32_t BoardEvaluator::_evaluateFields(Board &bd, int32_t phase)
+template <EvalMode mode>
+int32_t
+BoardEvaluator::_evaluateFields(Board &bd, int32_t phase, const PositionInfo &info, PawnHashTable *pawnTable)
 {
     static constexpr void (*EvalFunctions[])(
         _fieldEvalInfo_t &, Board &, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t
     ){_processFigEval<mode, KnightMap, _processKnightEval>, _processFigEval<mode, BishopMap, _processBishopEval>,
       _processFigEval<mode, RookMap, _processRookEval>, _processFigEval<mode, QueenMap, _processQueenEval>};
 
+    // piece-square values are kept up to date by the moves, only the remaining terms are computed below
     _fieldEvalInfo_t result{};
-    ChessMechanics mech{bd};
+    result.midgameEval = bd.PsqtMidgame;
+    result.endgameEval = bd.PsqtEndgame;
 
-    const uint64_t whiteMap = mech.GetColBitMap(WHITE);
-    const uint64_t blackMap = mech.GetColBitMap(BLACK);
-    const uint64_t fullMap  = blackMap | whiteMap;
+    const uint64_t whiteMap        = info.ColorMaps[WHITE];
+    const uint64_t blackMap        = info.ColorMaps[BLACK];
+    const uint64_t fullMap         = info.FullMap;
 
-    const auto [whitePinnedFigs, un1] =
-        mech.GetPinnedFigsMap<ChessMechanics::PinnedFigGen::WoutAllowedTiles>(WHITE, fullMap);
-    const auto [blackPinnedFigs, un2] =
-        mech.GetPinnedFigsMap<ChessMechanics::PinnedFigGen::WoutAllowedTiles>(BLACK, fullMap);
+    // pins of the side not to move are not needed by the move generation, so they are collected only here
+    const uint64_t enemyPinnedFigs =
+        ChessMechanics{bd}
+            .GetPinnedFigsMap<ChessMechanics::PinnedFigGen::WoutAllowedTiles>(SwapColor(bd.MovingColor), fullMap)
+            .first;
+    const uint64_t whitePinnedFigs = bd.MovingColor == WHITE ? info.PinnedFigs : enemyPinnedFigs;
+    const uint64_t blackPinnedFigs = bd.MovingColor == BLACK ? info.PinnedFigs : enemyPinnedFigs;
 
     // ------------------------------
     // Evaluating pawn figures
     // ------------------------------
 
-    const auto pEval                = _evaluatePawns<mode>(bd, blackPinnedFigs, whitePinnedFigs, fullMap);
+    const auto pEval                = _evaluatePawns<mode>(bd, blackPinnedFigs, whitePinnedFigs, fullMap, pawnTable);
     const uint64_t whitePawnControl = pEval.whiteControlledFields;
     const uint64_t blackPawnControl = pEval.blackControlledFields;
 
@@ -0,0 +1,83 @@
+//
+// Created by Jlisowskyy on 10/17/26.
+//
+
+#ifndef DIRECTMAPPEDTABLE_H
+#define DIRECTMAPPEDTABLE_H
+
+#include <cinttypes>
+#include <memory>
+#include <utility>
+
+#include "../CompilationConstants.h"
+
+/*
+ *      Per-thread direct-mapped table of 'Size' entries, indexed by the lowest bits of the key.
+ *
+ *      Every entry type has to start with 'uint64_t Key' field, which identifies the stored position. There is no
+ *      replacement scheme, a newer key always takes the slot over. Every thread owns its tables,
+ *      so no synchronization is needed. Tables keep counters of probes and hits used by the search statistics.
+ */
+
+template <class EntryT, size_t Size> class DirectMappedTable
+{
+    static_assert((Size & (Size - 1)) == 0, "Table size must be a power of two!");
+
+    public:
+    // ------------------------------
+    // Class inner types
+    // ------------------------------
+
+    using Entry = EntryT;
+
+    // ------------------------------
+    // Class creation
+    // ------------------------------
+
+    DirectMappedTable() : _entries(std::make_unique<Entry[]>(Size)) {}
+
+    ~DirectMappedTable() = default;
+
+    DirectMappedTable(const DirectMappedTable &)            = delete;
+    DirectMappedTable &operator=(const DirectMappedTable &) = delete;
+
+    // ------------------------------
+    // Class interaction
+    // ------------------------------
+
+    /* Returns the entry of the passed key and whether it was already computed, on a miss the entry is taken over
+     * by the passed key and has to be filled by the caller */
+    [[nodiscard]] INLINE std::pair<Entry *, bool> Probe(const uint64_t key)
+    {
+        Entry *entry     = &_entries[key & (Size - 1)];
+        const bool isHit = entry->Key == key;
+
+        ++_probes;
+        _hits += isHit;
+
+        entry->Key = key;
+        return {entry, isHit};
+    }
+
+    [[nodiscard]] uint64_t GetProbes() const { return _probes; }
+
+    [[nodiscard]] uint64_t GetHits() const { return _hits; }
+
+    void ResetStatistics()
+    {
+        _probes = 0;
+        _hits   = 0;
+    }
+
+    // ------------------------------
+    // Class fields
+    // ------------------------------
+
+    private:
+    std::unique_ptr<Entry[]> _entries;
+
+    uint64_t _probes{};
+    uint64_t _hits{};
+};
+
+#endif // DIRECTMAPPEDTABLE_H
@@ -0,0 +1,149 @@
+//
+// Created by Jlisowskyy on 10/17/26.
+//
+
+#ifndef ENDGAMEEVALUATOR_H
+#define ENDGAMEEVALUATOR_H
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstdlib>
+
+#include "../BitOperations.h"
+#include "../Board.h"
+#include "../EngineUtils.h"
+
+/*
+ *      Static class gathering dedicated evaluation functions of known endgames. The general evaluation has no idea
+ *      how to make progress in such positions, e.g. where to drive the lonely king to mate it, so those are scored
+ *      separately. The function is chosen once per material signature and cached inside the material hash table.
+ *
+ *      Currently supported endgames (for both colors):
+ *      - KRK - king and rook against lonely king, drives the king to any edge
+ *      - KBNK - king, bishop and knight against lonely king, drives the king to the corner of the bishop color
+ *
+ *      All functions return values from the white perspective in the same units as the full evaluation.
+ */
+
+struct EndgameEvaluator
+{
+    using EvalFuncT = int32_t (*)(const Board &bd);
+
+    // ------------------------------
+    // Class creation
+    // ------------------------------
+
+    EndgameEvaluator()  = delete;
+    ~EndgameEvaluator() = delete;
+
+    // ------------------------------
+    // Class interaction
+    // ------------------------------
+
+    /* Returns the dedicated evaluation function for material present on the board or nullptr when there is none */
+    [[nodiscard]] static EvalFuncT GetEvaluator(const Board &bd)
+    {
+        for (const int col : {WHITE, BLACK})
+        {
+            if (!_hasFigures(bd, SwapColor(col), {0, 0, 0, 0, 0}))
+                continue;
+
+            if (_hasFigures(bd, col, {0, 0, 0, 1, 0}))
+                return col == WHITE ? _evalKRK<WHITE> : _evalKRK<BLACK>;
+
+            if (_hasFigures(bd, col, {0, 1, 1, 0, 0}))
+                return col == WHITE ? _evalKBNK<WHITE> : _evalKBNK<BLACK>;
+        }
+
+        return nullptr;
+    }
+
+    // ------------------------------
+    // Private class methods
+    // ------------------------------
+
+    private:
+    // checks whether given color has exactly passed numbers of pawns, knights, bishops, rooks and queens
+    static bool _hasFigures(const Board &bd, const int col, const std::array<int, kingIndex> &counts)
+    {
+        for (size_t fig = 0; fig < kingIndex; ++fig)
+            if (CountOnesInBoard(bd.BitBoards[col * Board::BitBoardsPerCol + fig]) != counts[fig])
+                return false;
+
+        return true;
+    }
+
+    template <int strongCol> static int32_t _evalKRK(const Board &bd)
+    {
+        const int strongKing = ExtractMsbPos(bd.BitBoards[strongCol * Board::BitBoardsPerCol + kingIndex]);
+        const int weakKing   = ExtractMsbPos(bd.BitBoards[SwapColor(strongCol) * Board::BitBoardsPerCol + kingIndex]);
+
+        const int32_t eval = KnownWinBonus + RookValue + PushToEdgeBonus * _centerDistance(weakKing) +
+                             PushCloseBonus * (MaxKingDistance - _kingDistance(strongKing, weakKing));
+
+        return strongCol == WHITE ? eval : -eval;
+    }
+
+    template <int strongCol> static int32_t _evalKBNK(const Board &bd)
+    {
+        const int strongKing = ExtractMsbPos(bd.BitBoards[strongCol * Board::BitBoardsPerCol + kingIndex]);
+        const int weakKing   = ExtractMsbPos(bd.BitBoards[SwapColor(strongCol) * Board::BitBoardsPerCol + kingIndex]);
+        const int bishop     = ExtractMsbPos(bd.BitBoards[strongCol * Board::BitBoardsPerCol + bishopsIndex]);
+
+        // mate is possible only in the corners of the bishop color
+        const auto &corners  = _fieldColor(bishop) == _fieldColor(0) ? SameColorCorners[0] : SameColorCorners[1];
+        const int cornerDist = std::min(_kingDistance(weakKing, corners[0]), _kingDistance(weakKing, corners[1]));
+
+        const int32_t eval = KnownWinBonus + KnightValue + BishopValue + PushToEdgeBonus * _centerDistance(weakKing) +
+                             PushToCornerBonus * (MaxKingDistance - cornerDist) +
+                             PushCloseBonus * (MaxKingDistance - _kingDistance(strongKing, weakKing));
+
+        return strongCol == WHITE ? eval : -eval;
+    }
+
+    static constexpr int _file(const int msbPos) { return msbPos % 8; }
+
+    static constexpr int _rank(const int msbPos) { return msbPos / 8; }
+
+    static constexpr int _fieldColor(const int msbPos) { return (_file(msbPos) + _rank(msbPos)) % 2; }
+
+    // number of king moves needed to go from one field to the other on the empty board
+    static constexpr int _kingDistance(const int a, const int b)
+    {
+        return std::max(std::abs(_file(a) - _file(b)), std::abs(_rank(a) - _rank(b)));
+    }
+
+    // sum of file and rank distances to the 4 center fields, 0 in the center and 6 in the corners
+    static constexpr int _centerDistance(const int msbPos)
+    {
+        return std::max(3 - _file(msbPos), _file(msbPos) - 4) + std::max(3 - _rank(msbPos), _rank(msbPos) - 4);
+    }
+
+    // ------------------------------
+    // Class fields
+    // ------------------------------
+
+    // Bonus making the known won endgame clearly better than any regular position with similar material
+    static constexpr int32_t KnownWinBonus = 1000;
+
+    static constexpr int32_t KnightValue = 325;
+    static constexpr int32_t BishopValue = 325;
+    static constexpr int32_t RookValue   = 500;
+
+    // Bonuses guiding the strong side to mate: losing king pushed away from the center or toward the mating corner,
+    // and the kings brought close to each other
+    static constexpr int32_t PushToEdgeBonus   = 20;
+    static constexpr int32_t PushToCornerBonus = 60;
+    static constexpr int32_t PushCloseBonus    = 10;
+
+    static constexpr int MaxKingDistance = 7;
+
+    // corners grouped by their field color, first pair shares the color with the field 0
+    static constexpr int SameColorCorners[2][2] = {
+        {0, 63},
+        {7, 56},
+    };
+};
+
+#endif // ENDGAMEEVALUATOR_H
@@ -0,0 +1,106 @@
+//
+// Created by Jlisowskyy on 10/17/26.
+//
+
+#ifndef EVALCACHE_H
+#define EVALCACHE_H
+
+#include <cinttypes>
+#include <memory>
+
+#include "../CompilationConstants.h"
+
+/*
+ *      Per-thread direct-mapped cache of the static evaluation, indexed by the zobrist hash of the position.
+ *
+ *      Static eval saved inside the TT entry is lost as soon as the entry gets replaced, which happens constantly in
+ *      the quiesce search, so the same leaves end up evaluated many times per iteration. This small table keeps only
+ *      the evaluation, so it stays much denser than the TT and is probed before the full evaluation is run.
+ *
+ *      Every entry takes 8 bytes: upper 48 bits of the hash are used as the key and the lower 16 bits store the eval
+ *      from the moving color perspective. Every thread owns its cache, so no synchronization is needed.
+ *
+ *      Resources: https://www.chessprogramming.org/Evaluation_Hash_Table
+ */
+
+class EvalCache
+{
+    public:
+    // ------------------------------
+    // Class creation
+    // ------------------------------
+
+    explicit EvalCache(const size_t sizeMB = EVAL_CACHE_DEFAULT_SIZE_MB) { Resize(sizeMB); }
+
+    ~EvalCache() = default;
+
+    EvalCache(const EvalCache &)            = delete;
+    EvalCache &operator=(const EvalCache &) = delete;
+
+    // ------------------------------
+    // Class interaction
+    // ------------------------------
+
+    // allocates the cache with size rounded down to the power of two, size 0 disables the cache
+    void Resize(const size_t sizeMB)
+    {
+        _entries.reset();
+        _mask = 0;
+
+        if (sizeMB == 0)
+            return;
+
+        size_t entryCount = 1;
+        while (2 * entryCount * sizeof(uint64_t) <= sizeMB * MB) entryCount *= 2;
+
+        _entries = std::make_unique<uint64_t[]>(entryCount);
+        _mask    = entryCount - 1;
+    }
+
+    [[nodiscard]] bool IsEnabled() const { return _entries != nullptr; }
+
+    /* Returns true and fills the eval when the position was already evaluated, cache must be enabled */
+    [[nodiscard]] INLINE bool Probe(const uint64_t zHash, int &eval)
+    {
+        const uint64_t entry = _entries[zHash & _mask];
+        const bool isHit     = (entry & KeyMask) == (zHash & KeyMask);
+
+        ++_probes;
+        _hits += isHit;
+
+        eval = static_cast<int16_t>(entry & EvalMask);
+        return isHit;
+    }
+
+    /* Always replaces the previous entry, eval must fit inside the score range */
+    INLINE void Store(const uint64_t zHash, const int eval)
+    {
+        _entries[zHash & _mask] = (zHash & KeyMask) | static_cast<uint16_t>(eval);
+    }
+
+    [[nodiscard]] uint64_t GetProbes() const { return _probes; }
+
+    [[nodiscard]] uint64_t GetHits() const { return _hits; }
+
+    void ResetStatistics()
+    {
+        _probes = 0;
+        _hits   = 0;
+    }
+
+    // ------------------------------
+    // Class fields
+    // ------------------------------
+
+    private:
+    static constexpr uint64_t EvalMask = 0xFFFF;
+    static constexpr uint64_t KeyMask  = ~EvalMask;
+
+    std::unique_ptr<uint64_t[]> _entries;
+    uint64_t _mask{};
+
+    uint64_t _probes{};
+    uint64_t _hits{};
+};
+
+#endif // EVALCACHE_H
@@ -0,0 +1,39 @@
+//
+// Created by Jlisowskyy on 10/17/26.
+//
+
+#ifndef MATERIALHASHTABLE_H
+#define MATERIALHASHTABLE_H
+
+#include <cinttypes>
+
+#include "../CompilationConstants.h"
+#include "DirectMappedTable.h"
+#include "EndgameEvaluator.h"
+
+/*
+ *      Entry of the table caching evaluation of the material signature, indexed by Board::MaterialKey.
+ *
+ *      Material changes only on captures and promotions, so the figures are counted and the material is scored once
+ *      per signature instead of at every leaf. Together with the score the entry keeps information
+ *      whether the material is an enforced draw and the dedicated evaluation function of known endgames.
+ *      Game phase is not stored, it is always taken from Board::PhaseWeights.
+ */
+
+struct MaterialHashEntry
+{
+    uint64_t Key;
+
+    // nullptr when the position should be evaluated by the full evaluation
+    EndgameEvaluator::EvalFuncT Endgame;
+
+    // from the white perspective, not used when the material is drawn
+    int32_t MaterialEval;
+    bool IsDraw;
+};
+
+static_assert(sizeof(MaterialHashEntry) == 24);
+
+using MaterialHashTable = DirectMappedTable<MaterialHashEntry, MATERIAL_HASH_TABLE_SIZE>;
+
+#endif // MATERIALHASHTABLE_H
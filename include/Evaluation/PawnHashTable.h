@@ -0,0 +1,40 @@
+//
+// Created by Jlisowskyy on 10/17/26.
+//
+
+#ifndef PAWNHASHTABLE_H
+#define PAWNHASHTABLE_H
+
+#include <cinttypes>
+
+#include "../CompilationConstants.h"
+#include "DirectMappedTable.h"
+
+/*
+ *      Entry of the table caching evaluation of the pawn structure, indexed by Board::PawnKey.
+ *
+ *      Pawn structure changes only on a small fraction of moves, so the terms depending on pawns only are computed
+ *      once per pawn configuration. Terms depending also on pins or on the kings positions are not stored.
+ *
+ *      Zeroed entry is valid for the position without pawns, whose key is zero as well.
+ */
+
+struct alignas(64) PawnHashEntry
+{
+    uint64_t Key;
+
+    // structure eval from the white perspective
+    int32_t MidgameEval;
+    int32_t EndgameEval;
+
+    // indexed by color
+    uint64_t PassedPawns[2];
+    uint64_t PawnAttacks[2];
+    uint64_t AttackSpans[2];
+};
+
+static_assert(sizeof(PawnHashEntry) == 64);
+
+using PawnHashTable = DirectMappedTable<PawnHashEntry, PAWN_HASH_TABLE_SIZE>;
+
+#endif // PAWNHASHTABLE_H
@@ -0,0 +1,204 @@
+//
+// Created by Jlisowskyy on 10/17/26.
+//
+
+#ifndef PIECESQUARETABLES_H
+#define PIECESQUARETABLES_H
+
+#include <array>
+#include <cinttypes>
+
+#include "../Board.h"
+
+/*
+ *      Piece-square tables and game phase weights used by the evaluation.
+ *
+ *      Both depend only on the figure and its field, so their sums over the whole board are kept inside the Board
+ *      (PsqtMidgame, PsqtEndgame and PhaseWeights) and updated on every move with the figures that were moved, killed
+ *      or placed. The evaluation then only adds the terms that can not be updated incrementally.
+ *
+ *      Sums are kept from the white perspective, that is black figures contribute negated values.
+ *      Tables are indexed with msb position of white figures, black figures use mirrored fields.
+ */
+
+using PieceSquareBoardTables = std::array<std::array<int16_t, Board::BitBoardFields>, Board::BitBoardsCount + 1>;
+
+/* Builds tables indexed by board index (including the sentinel one) and msb position from the tables of single figure
+ * types, black figures get mirrored and negated values. Missing table means the figure type is not evaluated. */
+constexpr PieceSquareBoardTables
+BuildPieceSquareBoardTables(const std::array<const int16_t *, Board::BitBoardsPerCol> &tables)
+{
+    PieceSquareBoardTables rv{};
+
+    for (size_t fig = 0; fig < Board::BitBoardsPerCol; ++fig)
+    {
+        if (tables[fig] == nullptr)
+            continue;
+
+        for (int msbPos = 0; msbPos < static_cast<int>(Board::BitBoardFields); ++msbPos)
+        {
+            rv[fig][msbPos]                          = tables[fig][msbPos];
+            rv[Board::BitBoardsPerCol + fig][msbPos] = static_cast<int16_t>(-tables[fig][ConvertToReversedPos(msbPos)]);
+        }
+    }
+
+    return rv;
+}
+
+struct PieceSquareTables
+{
+    // ------------------------------
+    // Class interaction
+    // ------------------------------
+
+    /* Updates the sums after the figure was placed on the field */
+    static INLINE void AddFigure(Board &bd, const size_t boardIndex, const int msbPos)
+    {
+        bd.PsqtMidgame += MidgameValues[boardIndex][msbPos];
+        bd.PsqtEndgame += EndgameValues[boardIndex][msbPos];
+        bd.PhaseWeights += BoardPhases[boardIndex];
+    }
+
+    /* Updates the sums after the figure was removed from the field */
+    static INLINE void RemoveFigure(Board &bd, const size_t boardIndex, const int msbPos)
+    {
+        bd.PsqtMidgame -= MidgameValues[boardIndex][msbPos];
+        bd.PsqtEndgame -= EndgameValues[boardIndex][msbPos];
+        bd.PhaseWeights -= BoardPhases[boardIndex];
+    }
+
+    /* Rebuilds all sums from the bitboards, must be used after any direct modification of the bitboards */
+    static void Recompute(Board &bd)
+    {
+        bd.PsqtMidgame  = 0;
+        bd.PsqtEndgame  = 0;
+        bd.PhaseWeights = 0;
+
+        for (size_t ind = 0; ind < Board::BitBoardsCount; ++ind)
+            for (uint64_t figs = bd.BitBoards[ind]; figs; figs ^= ExtractLsbBit(figs))
+                AddFigure(bd, ind, ExtractMsbPos(ExtractLsbBit(figs)));
+    }
+
+    // ------------------------------
+    // Class fields
+    // ------------------------------
+
+    // Weights below are used to calculate game phase based on the number of figures on the board
+    static constexpr int16_t PawnPhase   = 0;
+    static constexpr int16_t KnightPhase = 1;
+    static constexpr int16_t BishopPhase = 1;
+    static constexpr int16_t RookPhase   = 2;
+    static constexpr int16_t QueenPhase  = 4;
+
+    static constexpr int16_t FigurePhases[] = {PawnPhase, KnightPhase, BishopPhase, RookPhase, QueenPhase};
+
+    // Full phase based on available figure counts
+    static constexpr int16_t FullPhase = 4 * KnightPhase + 4 * BishopPhase + 4 * RookPhase + 2 * QueenPhase;
+
+    // ----------------------------------------------
+    // Figure-Position bonuses/penalties tables
+    // ----------------------------------------------
+
+    // IMPORTANT: PREVENTS FROM REMOVING BOARD FORMAT
+    // clang-format off
+    static constexpr int16_t BasicBlackPawnPositionValues[]{
+         0,  0,   0,   0,   0,   0,  0,  0,
+        40, 40,  40,  40,  40,  40, 40, 40,
+        30, 30,  30,  30,  30,  30, 30, 30,
+        20, 20,  20,  20,  20,  20, 20, 20,
+        10, 10,  10,  10,  10,  10, 10, 10,
+         5,  5,   5,   5,   5,   5,  5,  5,
+         0,  0,   0,   0,   0,   0,  0,  0,
+         0,  0,   0,   0,   0,   0,  0,  0
+    };
+
+    static constexpr int16_t BasicBlackPawnPositionEndValues[]{
+         0,  0,   0,   0,   0,   0,  0,  0,
+        80, 80,  80,  80,  80,  80, 80, 80,
+        60, 60,  60,  60,  60,  60, 60, 60,
+        40, 40,  40,  40,  40,  40, 40, 40,
+        20, 20,  20,  20,  20,  20, 20, 20,
+        10, 10,  10,  10,  10,  10, 10, 10,
+         0,  0,   0,   0,   0,   0,  0,  0,
+         0,  0,   0,   0,   0,   0,  0,  0
+    };
+
+    static constexpr int16_t BasicBlackKnightPositionValues[]{
+        -50,-40,-30,-30,-30,-30,-40,-50,
+        -40,-20,  0,  0,  0,  0,-20,-40,
+        -30,  0, 10, 15, 15, 10,  0,-30,
+        -30,  5, 15, 20, 20, 15,  5,-30,
+        -30,  0, 15, 20, 20, 15,  0,-30,
+        -30,  5, 10, 15, 15, 10,  5,-30,
+        -40,-20,  0,  5,  5,  0,-20,-40,
+        -50,-40,-30,-30,-30,-30,-40,-50,
+    };
+
+    static constexpr int16_t BasicBlackBishopPositionValues[]{
+        -20, -10, -10, -10, -10, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,  10,  10,   5,   0, -10,
+        -10,   5,   5,  10,  10,   5,   5, -10,
+        -10,   0,  10,  10,  10,  10,   0, -10,
+        -10,  10,  10,  10,  10,  10,  10, -10,
+        -10,   5,   0,   0,   0,   0,   5, -10,
+        -20, -10, -10, -10, -10, -10, -10, -20,
+    };
+
+    static constexpr int16_t BasicBlackQueenPositionValues[]{
+        -20,-10,-10, -5, -5,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5,  5,  5,  5,  0,-10,
+         -5,  0,  5,  5,  5,  5,  0, -5,
+          0,  0,  5,  5,  5,  5,  0, -5,
+        -10,  5,  5,  5,  5,  5,  0,-10,
+        -10,  0,  5,  0,  0,  0,  0,-10,
+        -20,-10,-10, -5, -5,-10,-10,-20
+    };
+
+    static constexpr int16_t BasicBlackKingPositionValues[]{
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -20, -30, -30, -40, -40, -30, -30, -20,
+        -10, -20, -20, -20, -20, -20, -20, -10,
+         20,  20,   0,   0,   0,   0,  20,  20,
+         20,  30,  10,   0,   0,  10,  30,  20
+    };
+
+    static constexpr int16_t BasicBlackKingEndPositionValues[]{
+        -50, -40, -30, -20, -20, -30, -40, -50,
+        -30, -20, -10,   0,   0, -10, -20, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -30,   0,   0,   0,   0, -30, -30,
+        -50, -30, -30, -30, -30, -30, -30, -50
+    };
+    // clang-format on
+
+    private:
+    // ------------------------------
+    // Private class fields
+    // ------------------------------
+
+    // rooks are not evaluated by position, queens only in the middle game
+    static constexpr PieceSquareBoardTables MidgameValues = BuildPieceSquareBoardTables({
+        BasicBlackPawnPositionValues, BasicBlackKnightPositionValues, BasicBlackBishopPositionValues, nullptr,
+        BasicBlackQueenPositionValues, BasicBlackKingPositionValues
+    });
+
+    static constexpr PieceSquareBoardTables EndgameValues = BuildPieceSquareBoardTables({
+        BasicBlackPawnPositionEndValues, BasicBlackKnightPositionValues, BasicBlackBishopPositionValues, nullptr,
+        nullptr, BasicBlackKingEndPositionValues
+    });
+
+    static constexpr std::array<int16_t, Board::BitBoardsCount + 1> BoardPhases{
+        PawnPhase, KnightPhase, BishopPhase, RookPhase, QueenPhase, 0,
+        PawnPhase, KnightPhase, BishopPhase, RookPhase, QueenPhase, 0, 0
+    };
+};
+
+#endif // PIECESQUARETABLES_H
@@ -74,6 +74,26 @@ struct StructureEvaluator
         return ((enemyPawns & FileMap::GetFronFatFile(pawnsMsbPos, col)) == 0) * PassedPawnBonus;
     }
 
+    // Method returns all fields pawns of given color could attack while advancing, that is the passed attacks filled
+    // toward the promotion rank.
+    static INLINE uint64_t GetAttackSpan(uint64_t pawnAttacks, const int col)
+    {
+        if (col == WHITE)
+        {
+            pawnAttacks |= pawnAttacks << 8;
+            pawnAttacks |= pawnAttacks << 16;
+            pawnAttacks |= pawnAttacks << 32;
+        }
+        else
+        {
+            pawnAttacks |= pawnAttacks >> 8;
+            pawnAttacks |= pawnAttacks >> 16;
+            pawnAttacks |= pawnAttacks >> 32;
+        }
+
+        return pawnAttacks;
+    }
+
     // ------------------------------
     // Class fields
     // ------------------------------
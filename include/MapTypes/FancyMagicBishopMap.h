@@ -11,11 +11,25 @@
 #include "../MovesHashMap.h"
 #include "HashFunctions.h"
 
+/*
+ *      Moves of every field are stored inside single packed array, each field owns only as many entries as its magic
+ *      index range requires. Everything needed to index the array is kept in single 32-byte record per field.
+ *      Underlying MovesHashMap is used only by the magic parameters search.
+ */
+
 class FancyMagicBishopMap
 {
     using _hashFuncT      = FancyMagicHashFunction<SparseRandomGenerator<>>;
     using _underlyingMapT = MovesHashMap<_hashFuncT, BishopMapGenerator::MaxPossibleNeighborsWithOverlap>;
 
+    struct alignas(32) _fieldMagic
+    {
+        uint64_t mask;
+        uint64_t magic;
+        uint64_t offset;
+        uint64_t shift;
+    };
+
     public:
     constexpr FancyMagicBishopMap();
 
@@ -94,41 +108,45 @@ class FancyMagicBishopMap
         _hashFuncT(std::make_tuple(2306977739592179777LLU, 5)),
         _hashFuncT(std::make_tuple(18381131039969901408LLU, 6)),
     };
-    std::array<_underlyingMapT, Board::BitBoardFields> _maps;
+    // sum of index ranges of all fields
+    static constexpr size_t MovesCount = []
+    {
+        size_t count{};
+        for (const _hashFuncT &func : funcs) count += MinMsbPossible << std::get<1>(func.GetParams());
+        return count;
+    }();
+
+    std::array<_fieldMagic, Board::BitBoardFields> _fields{};
+    std::array<uint64_t, MovesCount> _moves{};
 };
 
 constexpr FancyMagicBishopMap::FancyMagicBishopMap()
 {
+    uint64_t offset{};
+
     for (int i = 0; i < static_cast<int>(Board::BitBoardFields); ++i)
     {
-        const int boardIndex = ConvertToReversedPos(i);
-
-        _maps[i] = _underlyingMapT(BishopMapGenerator::InitMasks(boardIndex), funcs[i]);
-        _maps[i].InitFullMask();
-
-        MoveInitializer(
-            _maps[i],
-            [](const uint64_t n, const int ind) constexpr
-            {
-                return BishopMapGenerator::GenMoves(n, ind);
-            },
-            []([[maybe_unused]] const int, const BishopMapGenerator::MasksT &m) constexpr
-            {
-                return BishopMapGenerator::GenPossibleNeighborsWithOverlap(m);
-            },
-            [](const uint64_t b, const BishopMapGenerator::MasksT &m) constexpr
-            {
-                return BishopMapGenerator::StripBlockingNeighbors(b, m);
-            },
-            boardIndex
-        );
+        const int boardIndex     = ConvertToReversedPos(i);
+        const auto masks         = BishopMapGenerator::InitMasks(boardIndex);
+        const auto [magic, bits] = funcs[i].GetParams();
+
+        _fields[i] = {masks[0] | masks[1] | masks[2] | masks[3], magic, offset, 64 - bits};
+
+        const auto [possibilities, posSize] = BishopMapGenerator::GenPossibleNeighborsWithOverlap(masks);
+        for (size_t j = 0; j < posSize; ++j)
+        {
+            const uint64_t strippedNeighbors = BishopMapGenerator::StripBlockingNeighbors(possibilities[j], masks);
+            _moves[offset + funcs[i](possibilities[j])] = BishopMapGenerator::GenMoves(strippedNeighbors, boardIndex);
+        }
+
+        offset += MinMsbPossible << bits;
     }
 }
 
 constexpr uint64_t FancyMagicBishopMap::GetMoves(const int msbInd, const uint64_t fullBoard) const
 {
-    const uint64_t neighbors = fullBoard & _maps[msbInd].fullMask;
-    return _maps[msbInd][neighbors];
+    const _fieldMagic &field = _fields[msbInd];
+    return _moves[field.offset + (((fullBoard & field.mask) * field.magic) >> field.shift)];
 }
 
 #endif // FANCYMAGICBISHOPMAP_H
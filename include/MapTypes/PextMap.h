@@ -0,0 +1,114 @@
+//
+// Created by Jlisowskyy on 10/17/26.
+//
+
+#ifndef PEXTMAP_H
+#define PEXTMAP_H
+
+#include <array>
+
+#include "../BitOperations.h"
+#include "../EngineUtils.h"
+#include "../MoveGeneration/BishopMapGenerator.h"
+#include "../MoveGeneration/RookMapGenerator.h"
+
+/*
+ *      Sliding figure map indexed with parallel bits extract (PEXT) of the blocking neighbors.
+ *      Extracted bits directly form a dense index, so no magic multiplication is needed, and every field owns exactly
+ *      2^(number of mask bits) entries inside single shared moves array.
+ *
+ *      Should be used only when the target supports BMI2, otherwise the extraction is emulated by a slow loop.
+ *      Generator class must provide the same interface as RookMapGenerator and BishopMapGenerator do.
+ *
+ *      Resources: https://www.chessprogramming.org/BMI2#PEXTBitboards
+ */
+
+template <class MapGeneratorT> class PextMap
+{
+    // ------------------------------
+    // Class inner types
+    // ------------------------------
+
+    struct _fieldInfo
+    {
+        uint64_t mask;
+        uint64_t offset;
+    };
+
+    public:
+    // ------------------------------
+    // Class creation
+    // ------------------------------
+
+    constexpr PextMap();
+
+    // ------------------------------
+    // Class interaction
+    // ------------------------------
+
+    [[nodiscard]] constexpr uint64_t GetMoves(int msbInd, uint64_t fullBoard) const;
+
+    // ------------------------------
+    // Private class methods
+    // ------------------------------
+
+    private:
+    static constexpr uint64_t _getFullMask(const int boardIndex)
+    {
+        const auto masks = MapGeneratorT::InitMasks(boardIndex);
+        return masks[0] | masks[1] | masks[2] | masks[3];
+    }
+
+    static constexpr size_t _getMovesCount()
+    {
+        size_t count{};
+        for (int i = 0; i < static_cast<int>(Board::BitBoardFields); ++i)
+            count += MinMsbPossible << CountOnesInBoard(_getFullMask(ConvertToReversedPos(i)));
+        return count;
+    }
+
+    // ------------------------------
+    // Class fields
+    // ------------------------------
+
+    static constexpr size_t MovesCount = _getMovesCount();
+
+    std::array<_fieldInfo, Board::BitBoardFields> _fields{};
+    std::array<uint64_t, MovesCount> _moves{};
+};
+
+template <class MapGeneratorT> constexpr PextMap<MapGeneratorT>::PextMap()
+{
+    uint64_t offset{};
+
+    for (int i = 0; i < static_cast<int>(Board::BitBoardFields); ++i)
+    {
+        const int boardIndex = ConvertToReversedPos(i);
+        const auto masks     = MapGeneratorT::InitMasks(boardIndex);
+        const uint64_t mask  = masks[0] | masks[1] | masks[2] | masks[3];
+
+        _fields[i] = {mask, offset};
+
+        const auto [possibilities, posSize] = MapGeneratorT::GenPossibleNeighborsWithOverlap(masks);
+        for (size_t j = 0; j < posSize; ++j)
+        {
+            const uint64_t strippedNeighbors = MapGeneratorT::StripBlockingNeighbors(possibilities[j], masks);
+            _moves[offset + ExtractBitsByMask(possibilities[j], mask)] =
+                MapGeneratorT::GenMoves(strippedNeighbors, boardIndex);
+        }
+
+        offset += MinMsbPossible << CountOnesInBoard(mask);
+    }
+}
+
+template <class MapGeneratorT>
+constexpr uint64_t PextMap<MapGeneratorT>::GetMoves(const int msbInd, const uint64_t fullBoard) const
+{
+    const _fieldInfo &info = _fields[msbInd];
+    return _moves[info.offset + ExtractBitsByMask(fullBoard, info.mask)];
+}
+
+using PextRookMap   = PextMap<RookMapGenerator>;
+using PextBishopMap = PextMap<BishopMapGenerator>;
+
+#endif // PEXTMAP_H
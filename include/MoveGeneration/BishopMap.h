@@ -5,7 +5,11 @@
 #ifndef BISHOPMAP_H
 #define BISHOPMAP_H
 
+#include <type_traits>
+
+#include "../CompilationConstants.h"
 #include "../MapTypes/FancyMagicBishopMap.h"
+#include "../MapTypes/PextMap.h"
 
 class BishopMap
 {
@@ -13,7 +17,7 @@ class BishopMap
     // Underlying map definition
     // -------------------------------
 
-    using _underlyingMap = FancyMagicBishopMap;
+    using _underlyingMap = std::conditional_t<UsePextMaps, PextBishopMap, FancyMagicBishopMap>;
 
     // ---------------------------------------
     // Class creation and initialization
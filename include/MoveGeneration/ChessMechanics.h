@@ -10,6 +10,7 @@
 
 #include "BishopMap.h"
 #include "Move.h"
+#include "PositionInfo.h"
 #include "RookMap.h"
 
 struct ChessMechanics
@@ -49,9 +50,9 @@ struct ChessMechanics
 
     [[nodiscard]] bool IsCheck() const;
 
-    [[nodiscard]] INLINE bool IsDrawByReps(const uint64_t hash)
+    [[nodiscard]] INLINE bool IsDrawByReps() const
     {
-        return _board.Repetitions.at(hash) >= 3 || _board.HalfMoves >= 50;
+        return _board.HalfMoves >= 50 || _board.CountRepetitions(_board.ZobristKey) >= 3;
     }
 
     // Gets occupancy maps, which simply indicates whether some field is occupied or not. Does not distinguish colors.
@@ -72,29 +73,20 @@ struct ChessMechanics
         return map;
     }
 
-    // does not check kings BitBoards!!!
-    [[nodiscard]] INLINE size_t GetIndexOfContainingBitBoard(const uint64_t map, const int col) const
-    {
-        const size_t colIndex = col * Board::BitBoardsPerCol;
-        size_t rv             = 0;
-        for (size_t i = 0; i < Board::BitBoardsPerCol; ++i)
-        {
-            rv += ((_board.BitBoards[colIndex + i] & map) != 0) * i;
-        }
-        return colIndex + rv;
-    }
+    /* Collects occupancy, attacks of the side not to move, checking figures and pinned figures of the moving side.
+     * Should be computed once per node and passed to the move generation, SEE and the evaluation. */
+    [[nodiscard]] PositionInfo GetPositionInfo() const;
 
-    // [blockedFigMap, checksCount, checkType]
-    [[nodiscard]] std::tuple<uint64_t, uint8_t, uint8_t> GetBlockedFieldBitMap(uint64_t fullMap) const;
+    /* Fills info.Attacks[col] using the occupancy already stored in info. Sliding figures attack through the king
+     * of the opposite color. */
+    void CollectAttacks(PositionInfo &info, int col) const;
 
     [[nodiscard]] uint64_t GenerateAllowedTilesForPrecisedPinnedFig(uint64_t figBoard, uint64_t fullMap) const;
 
-    // returns [ pinnedFigMap, allowedTilesMap ]
+    // returns [ pinnedFigMap, allowedTilesMap ], figures of given color are pinned to the king of the same color
     template <PinnedFigGen genType>
     [[nodiscard]] std::pair<uint64_t, uint64_t> GetPinnedFigsMap(int col, uint64_t fullMap) const;
 
-    [[nodiscard]] uint64_t GetAllowedTilesWhenCheckedByNonSliding() const;
-
     /* Simply picks the least valuable figure from 'pieces' set with given 'color'.
      * Returns bitboard containing position of that figure and index of that figure to 'pieceIndOut'
      * */
@@ -129,7 +121,23 @@ struct ChessMechanics
      * SEE - Static Exchange Evaluation - function used to get approximated gain
      * after making given move, that is: it performs every exchange on field given by the move
      * */
-    [[nodiscard]] int SEE(Move mv) const;
+    [[nodiscard]] INLINE int SEE(const Move mv) const { return _see(mv, GetFullBitMap()); }
+
+    /* Same as above, but reuses the occupancy already collected for the node */
+    [[nodiscard]] INLINE int SEE(const Move mv, const PositionInfo &info) const { return _see(mv, info.FullMap); }
+
+    /* Returns exactly SEE(mv) >= threshold, but stops the exchange as soon as the outcome relative to the threshold
+     * is decided. Should be preferred whenever the exact value is not needed. */
+    [[nodiscard]] INLINE bool SEEGe(const Move mv, const int threshold) const
+    {
+        return _seeGe(mv, GetFullBitMap(), threshold);
+    }
+
+    /* Same as above, but reuses the occupancy already collected for the node */
+    [[nodiscard]] INLINE bool SEEGe(const Move mv, const int threshold, const PositionInfo &info) const
+    {
+        return _seeGe(mv, info.FullMap, threshold);
+    }
 
     /* Function finds index of figure type based on given single bit BitBoard */
     static INLINE int FindFigType(const uint64_t BitBoard, const Board &bd)
@@ -149,6 +157,13 @@ struct ChessMechanics
     // ------------------------------
 
     private:
+    [[nodiscard]] int _see(Move mv, uint64_t fullMap) const;
+
+    [[nodiscard]] bool _seeGe(Move mv, uint64_t fullMap, int threshold) const;
+
+    /* Bonus for the side finishing the exchange, when its figure left on the field checks the enemy king */
+    [[nodiscard]] int _seeCheckBonus(int lastAttackerType, int enemyColor, int msbPos, uint64_t fullMap) const;
+
     [[nodiscard]] INLINE uint64_t _updateAttackers(const uint64_t fullMap, const int msbPos) const
     {
         const uint64_t bishops = (_board.BitBoards[wQueensIndex] | _board.BitBoards[bQueensIndex] |
@@ -177,10 +192,7 @@ struct ChessMechanics
      *  - xrayMap - contains every figure that attack could be potentially unlocked after other figures move,
      *              that is: queens, bishops, rooks and pawns
      * */
-    [[nodiscard]] inline INLINE _seePackage _prepareForSEE(int msbPos) const;
-
-    static std::pair<uint64_t, uint8_t>
-    _getRookBlockedMap(uint64_t rookMap, uint64_t fullMapWoutKing, uint64_t kingMap);
+    [[nodiscard]] inline INLINE _seePackage _prepareForSEE(int msbPos, uint64_t fullMap) const;
 
     template <class MoveGeneratorT>
     [[nodiscard]] INLINE static uint64_t _blockIterativeGenerator(uint64_t board, MoveGeneratorT mGen)
@@ -200,12 +212,16 @@ struct ChessMechanics
 
     // returns [ pinnedFigMap, allowedTilesMap ]
     template <class MoveMapT, PinnedFigGen type>
-    [[nodiscard]] std::pair<uint64_t, uint64_t> _getPinnedFigMaps(uint64_t fullMap, uint64_t possiblePinningFigs) const;
+    [[nodiscard]] std::pair<uint64_t, uint64_t>
+    _getPinnedFigMaps(int kingPos, uint64_t fullMap, uint64_t possiblePinningFigs) const;
 
     // ------------------------------
     // Class fields
     // ------------------------------
 
+    // Points granted by _seeCheckBonus
+    static constexpr int SeeCheckPoints = 200;
+
     protected:
     const Board &_board;
 };
@@ -217,26 +233,26 @@ std::pair<uint64_t, uint64_t> ChessMechanics::GetPinnedFigsMap(const int col, co
     TraceIfFalse(col == 1 || col == 0, "Invalid color!");
 
     const size_t enemyCord = SwapColor(col) * Board::BitBoardsPerCol;
+    const int kingPos      = _board.GetKingMsbPos(col);
 
     const auto [pinnedByRooks, allowedRooks] = _getPinnedFigMaps<RookMap, genType>(
-        fullMap, _board.BitBoards[enemyCord + rooksIndex] | _board.BitBoards[enemyCord + queensIndex]
+        kingPos, fullMap, _board.BitBoards[enemyCord + rooksIndex] | _board.BitBoards[enemyCord + queensIndex]
     );
 
     const auto [pinnedByBishops, allowedBishops] = _getPinnedFigMaps<BishopMap, genType>(
-        fullMap, _board.BitBoards[enemyCord + bishopsIndex] | _board.BitBoards[enemyCord + queensIndex]
+        kingPos, fullMap, _board.BitBoards[enemyCord + bishopsIndex] | _board.BitBoards[enemyCord + queensIndex]
     );
 
     return {pinnedByBishops | pinnedByRooks, allowedBishops | allowedRooks};
 }
 
 template <class MoveMapT, ChessMechanics::PinnedFigGen type>
-std::pair<uint64_t, uint64_t>
-ChessMechanics::_getPinnedFigMaps(const uint64_t fullMap, const uint64_t possiblePinningFigs) const
+std::pair<uint64_t, uint64_t> ChessMechanics::_getPinnedFigMaps(
+    const int kingPos, const uint64_t fullMap, const uint64_t possiblePinningFigs
+) const
 {
     uint64_t allowedTilesFigMap{};
     [[maybe_unused]] uint64_t pinnedFigMap{};
-
-    const int kingPos = _board.GetKingMsbPos(_board.MovingColor);
     // generating figs seen from king's rook perpective
     const uint64_t kingFigPerspectiveAttackedFields = MoveMapT::GetMoves(kingPos, fullMap);
     const uint64_t kingFigPerspectiveAttackedFigs   = kingFigPerspectiveAttackedFields & fullMap;
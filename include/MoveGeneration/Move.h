@@ -8,7 +8,9 @@
 #include <array>
 
 #include "../Board.h"
+#include "../Evaluation/PieceSquareTables.h"
 #include "../Interface/Logger.h"
+#include "../Search/ZobristHash.h"
 
 // TODO: repair description
 
@@ -130,13 +132,21 @@ struct VolatileBoardData
     VolatileBoardData() = delete;
 
     constexpr VolatileBoardData(const Board &bd)
-        : HalfMoves(bd.HalfMoves), Castlings(bd.Castlings), OldElPassant(bd.ElPassantField)
+        : HalfMoves(bd.HalfMoves), Castlings(bd.Castlings), OldElPassant(bd.ElPassantField), ZobristKey(bd.ZobristKey),
+          PawnKey(bd.PawnKey), MaterialKey(bd.MaterialKey), PsqtMidgame(bd.PsqtMidgame), PsqtEndgame(bd.PsqtEndgame),
+          PhaseWeights(bd.PhaseWeights)
     {
     }
 
     const int HalfMoves;
     const std::bitset<Board::CastlingCount + 1> Castlings;
     const uint64_t OldElPassant;
+    const uint64_t ZobristKey;
+    const uint64_t PawnKey;
+    const uint64_t MaterialKey;
+    const int32_t PsqtMidgame;
+    const int32_t PsqtEndgame;
+    const int32_t PhaseWeights;
 };
 
 class Move
@@ -184,6 +194,10 @@ class Move
     {
         TraceIfFalse(mv.IsOkeyMove(), "Given move is not valid!");
 
+        // hashes use the state before the move
+        _updateHashes(mv, bd);
+        _updateEvalSums(mv, bd);
+
         // removing the old piece from the board
         bd.BitBoards[mv.GetStartBoardIndex()] ^= MaxMsbPossible >> mv.GetStartField();
 
@@ -193,6 +207,12 @@ class Move
         // removing the killed figure in case no figure is killed index should be indicating to the sentinel
         bd.BitBoards[mv.GetKilledBoardIndex()] ^= MaxMsbPossible >> mv.GetKilledFigureField();
 
+        // updating the mailbox, killed field must be cleared before the target one is set as they may be the same
+        bd.PieceOnSquare[mv.GetStartField()] = Board::SentinelBoardIndex;
+        if (mv.GetKilledBoardIndex() != Board::SentinelBoardIndex)
+            bd.PieceOnSquare[mv.GetKilledFigureField()] = Board::SentinelBoardIndex;
+        bd.PieceOnSquare[mv.GetTargetField()] = static_cast<uint8_t>(mv.GetTargetBoardIndex());
+
         // applying new castling rights
         bd.Castlings = mv.GetCastlingRights();
 
@@ -205,6 +225,8 @@ class Move
         // applying additional castling operation
         const auto [boardIndex, field] = CastlingActions[mv.GetCastlingType()];
         bd.BitBoards[boardIndex] |= field;
+        if (mv.GetCastlingType())
+            bd.PieceOnSquare[ExtractMsbPos(field)] = static_cast<uint8_t>(boardIndex);
 
         bd.ChangePlayingColor();
     }
@@ -228,6 +250,12 @@ class Move
         // placing the killed figure in good place
         bd.BitBoards[mv.GetKilledBoardIndex()] |= MaxMsbPossible >> mv.GetKilledFigureField();
 
+        // restoring the mailbox in reverse order, so the killed figure overwrites the cleared target field
+        bd.PieceOnSquare[mv.GetTargetField()] = Board::SentinelBoardIndex;
+        if (mv.GetKilledBoardIndex() != Board::SentinelBoardIndex)
+            bd.PieceOnSquare[mv.GetKilledFigureField()] = static_cast<uint8_t>(mv.GetKilledBoardIndex());
+        bd.PieceOnSquare[mv.GetStartField()] = static_cast<uint8_t>(mv.GetStartBoardIndex());
+
         // recovering old castlings
         bd.Castlings = data.Castlings;
 
@@ -237,9 +265,21 @@ class Move
         // Reversing Half Moves
         bd.HalfMoves = data.HalfMoves;
 
+        // recovering old hashes
+        bd.ZobristKey  = data.ZobristKey;
+        bd.PawnKey     = data.PawnKey;
+        bd.MaterialKey = data.MaterialKey;
+
+        // recovering old evaluation sums
+        bd.PsqtMidgame  = data.PsqtMidgame;
+        bd.PsqtEndgame  = data.PsqtEndgame;
+        bd.PhaseWeights = data.PhaseWeights;
+
         // reverting castling operation
         const auto [boardIndex, field] = CastlingActions[mv.GetCastlingType()];
         bd.BitBoards[boardIndex] ^= field;
+        if (mv.GetCastlingType())
+            bd.PieceOnSquare[ExtractMsbPos(field)] = Board::SentinelBoardIndex;
     }
 
     void SetEval(const int16_t eval) { _eval = eval; }
@@ -288,18 +328,6 @@ class Move
         return (_packedIndexes & CastlingTypeMask) >> 12;
     }
 
-    void SetCheckType()
-    {
-        static constexpr uint16_t CheckTypeBit = 1LLU << 15;
-        _packedIndexes |= CheckTypeBit;
-    }
-
-    [[nodiscard]] bool IsChecking() const
-    {
-        static constexpr uint16_t CheckTypeBit = 1LLU << 15;
-        return _packedIndexes & CheckTypeBit;
-    }
-
     void SetKilledFigureField(const uint16_t killedFigureField) { _packedMisc |= killedFigureField; }
 
     [[nodiscard]] uint16_t GetKilledFigureField() const
@@ -341,11 +369,60 @@ class Move
     // Private class methods
     // ------------------------------
 
+    private:
+    static INLINE void _updateHashes(const Move mv, Board &bd)
+    {
+        uint64_t key = bd.ZobristKey ^ ZHasher.GetColorHash();
+
+        // moving the figure and removing the killed one, in case no figure is killed sentinel hashes are zeroed
+        key ^= ZHasher.GetPieceHash(mv.GetStartBoardIndex(), mv.GetStartField());
+        key ^= ZHasher.GetPieceHash(mv.GetTargetBoardIndex(), mv.GetTargetField());
+        key ^= ZHasher.GetPieceHash(mv.GetKilledBoardIndex(), mv.GetKilledFigureField());
+
+        key ^= ZHasher.GetElPassantHash(ExtractMsbPos(bd.ElPassantField)) ^
+               ZHasher.GetElPassantHash(mv.GetElPassantField());
+        key ^= ZHasher.GetCastlingHash(bd.Castlings) ^ ZHasher.GetCastlingHash(mv.GetCastlingRights());
+
+        // placing the rook in case of castling
+        const auto [boardIndex, field] = CastlingActions[mv.GetCastlingType()];
+        key ^= ZHasher.GetPieceHash(boardIndex, ExtractMsbPos(field));
+
+        bd.ZobristKey = key;
+        bd.PawnKey ^= ZHasher.GetPawnHash(mv.GetStartBoardIndex(), mv.GetStartField()) ^
+                      ZHasher.GetPawnHash(mv.GetTargetBoardIndex(), mv.GetTargetField()) ^
+                      ZHasher.GetPawnHash(mv.GetKilledBoardIndex(), mv.GetKilledFigureField());
+
+        // material changes only on captures and promotions, the last figure of given type is added or removed
+        if (mv.IsAttackingMove())
+        {
+            const size_t killed = mv.GetKilledBoardIndex();
+            bd.MaterialKey ^= ZHasher.GetMaterialHash(killed, CountOnesInBoard(bd.BitBoards[killed]) - 1);
+        }
+
+        if (mv._packedMove.IsPromo())
+        {
+            const size_t pawns    = mv.GetStartBoardIndex();
+            const size_t promoted = mv.GetTargetBoardIndex();
+            bd.MaterialKey ^= ZHasher.GetMaterialHash(pawns, CountOnesInBoard(bd.BitBoards[pawns]) - 1) ^
+                              ZHasher.GetMaterialHash(promoted, CountOnesInBoard(bd.BitBoards[promoted]));
+        }
+    }
+
+    static INLINE void _updateEvalSums(const Move mv, Board &bd)
+    {
+        // in case no figure is killed or no castling is done sentinel values are zeroed
+        PieceSquareTables::RemoveFigure(bd, mv.GetStartBoardIndex(), mv.GetStartField());
+        PieceSquareTables::AddFigure(bd, mv.GetTargetBoardIndex(), mv.GetTargetField());
+        PieceSquareTables::RemoveFigure(bd, mv.GetKilledBoardIndex(), mv.GetKilledFigureField());
+
+        const auto [boardIndex, field] = CastlingActions[mv.GetCastlingType()];
+        PieceSquareTables::AddFigure(bd, boardIndex, ExtractMsbPos(field));
+    }
+
     // ------------------------------
     // Class fields
     // ------------------------------
 
-    private:
     static constexpr uint16_t Bit4 = 0b1111;
     static constexpr uint16_t Bit6 = 0b111111;
     static constexpr uint16_t Bit3 = 0b111;
@@ -16,12 +16,14 @@
 #include "KingMap.h"
 #include "KnightMap.h"
 #include "Move.h"
+#include "PerftTable.h"
 #include "QueenMap.h"
 #include "RookMap.h"
 #include "WhitePawnMap.h"
 
 #include <array>
 #include <map>
+#include <vector>
 
 struct MoveGenerator : ChessMechanics
 {
@@ -36,10 +38,11 @@ struct MoveGenerator : ChessMechanics
 
     explicit MoveGenerator(
         const Board &bd, Stack<Move, DEFAULT_STACK_SIZE> &s, const HistoricTable &ht = {}, const KillerTable &kt = {},
-        const PackedMove counterMove = {}, const int ply = 0, const int mostRecentMovedSquare = 0
+        const PackedMove counterMove = {}, const int ply = 0, const int mostRecentMovedSquare = 0,
+        const PositionInfo *info = nullptr
     )
         : ChessMechanics(bd), _threadStack(s), _counterMove(counterMove), _kTable(kt), _hTable(ht), _ply(ply),
-          _mostRecentSq(mostRecentMovedSquare)
+          _mostRecentSq(mostRecentMovedSquare), _info(info != nullptr ? *info : GetPositionInfo())
     {
     }
 
@@ -53,12 +56,44 @@ struct MoveGenerator : ChessMechanics
     // Class interaction
     // ------------------------------
 
-    template <bool GenOnlyAttackMoves = false, bool ApplyHeuristicEval = true> payload GetMovesFast();
+    /* Generates legal moves, GenOnlyAttackMoves limits them to captures and promotions,
+     * GenOnlyQuietMoves to all other moves */
+    template <bool GenOnlyAttackMoves = false, bool ApplyHeuristicEval = true, bool GenOnlyQuietMoves = false>
+    payload GetMovesFast();
+
+    /* Generates legal moves of the figure standing on given field only, used to validate moves without generating
+     * every move in the position */
+    template <bool ApplyHeuristicEval = true> payload GetFigureMovesFast(int msbPos);
+
+    /* Generates quiet moves giving check: moves to fields attacking the enemy king directly and moves of figures
+     * uncovering attack of the sliding figure behind them. Must not be used when the king is checked. */
+    template <bool ApplyHeuristicEval = true> payload GetQuietChecksFast();
+
+    /* Returns whether the move attacks the enemy king directly from its target field. Flag is computed on demand,
+     * check fields are prepared on the first call, so the board must not be changed between the calls. */
+    [[nodiscard]] INLINE bool IsGivingCheck(const Move mv)
+    {
+        return (_getCheckFields()[mv.GetTargetBoardIndex() % Board::BitBoardsPerCol] &
+                (MaxMsbPossible >> mv.GetTargetField())) != 0;
+    }
+
+    /* Counts leaves below every root move. Root moves are distributed across the threads, one thread per passed
+     * stack. When the table is passed, counts of already visited subtrees are taken from it. */
+    static std::map<std::string, uint64_t> GetCountedMoves(
+        const Board &bd, int depth, const std::vector<stck *> &stacks, PerftTable *table = nullptr
+    );
 
-    std::map<std::string, uint64_t> GetCountedMoves(int depth);
     uint64_t CountMoves(Board &bd, int depth);
 
-    using ChessMechanics::IsCheck;
+    [[nodiscard]] INLINE bool IsCheck() const { return _info.IsCheck(); }
+
+    [[nodiscard]] INLINE int SEE(const Move mv) const { return ChessMechanics::SEE(mv, _info); }
+
+    [[nodiscard]] INLINE bool SEEGe(const Move mv, const int threshold) const
+    {
+        return ChessMechanics::SEEGe(mv, threshold, _info);
+    }
+
     using ChessMechanics::IsDrawByReps;
 
     // ------------------------------
@@ -66,51 +101,60 @@ struct MoveGenerator : ChessMechanics
     // ------------------------------
 
     private:
-    template <class MapT>
-    [[nodiscard]] INLINE bool _isGivingCheck(const int msbPos, const uint64_t fullMap, const int enemyColor) const
+    template <bool UseTable> uint64_t _countMoves(Board &bd, int depth, PerftTable *table);
+
+    // returns allowed target fields of quiet moves of given figure
+    [[nodiscard]] INLINE uint64_t _getQuietMovesFilter(const size_t figBoardIndex, const uint64_t figBoard) const
     {
-        const uint64_t enemyKing = _board.BitBoards[enemyColor * Board::BitBoardsPerCol + kingIndex];
-        const uint64_t moves     = MapT::GetMoves(msbPos, fullMap, 0);
+        const uint64_t filter = _quietMovesFilter[figBoardIndex % Board::BitBoardsPerCol];
 
-        return (enemyKing & moves) != 0;
+        // figure uncovering a check may go anywhere except the line it is blocking
+        if ((figBoard & _discoveringFigures) != 0)
+            return filter | ~_getBlockedLine(_board.GetKingMsbPos(SwapColor(_board.MovingColor)), figBoard);
+        return filter;
     }
 
-    template <class MapT> [[nodiscard]] INLINE bool _isPawnGivingCheck(const uint64_t pawnBitMap) const
+    // returns fields of the line going through the king and the figure, both excluded
+    [[nodiscard]] static INLINE uint64_t _getBlockedLine(const int kingMsbPos, const uint64_t figBoard)
     {
-        const int enemyColor     = SwapColor(MapT::GetColor());
-        const uint64_t enemyKing = _board.BitBoards[enemyColor * Board::BitBoardsPerCol + kingIndex];
-        const uint64_t moves     = MapT::GetAttackFields(pawnBitMap);
+        const int figPos = ExtractMsbPos(figBoard);
 
-        return (enemyKing & moves) != 0;
+        if (const uint64_t kingRookLines = RookMap::GetMoves(kingMsbPos, 0); (kingRookLines & figBoard) != 0)
+            return kingRookLines & RookMap::GetMoves(figPos, 0);
+        return BishopMap::GetMoves(kingMsbPos, 0) & BishopMap::GetMoves(figPos, 0);
     }
 
-    template <class MapT>
-    [[nodiscard]] INLINE bool
-    _isPromotingPawnGivingCheck(const int msbPos, const uint64_t fullMap, const int targetBitBoardIndex) const
+    // returns fields between the king of the moving side and the sliding figure checking it, including the figure
+    [[nodiscard]] INLINE uint64_t _getCheckBlockingFields() const
     {
-        static constexpr uint64_t (*moveGenerators[])(int, uint64_t, uint64_t){
-            nullptr, KnightMap::GetMoves, BishopMap::GetMoves, RookMap::GetMoves, QueenMap::GetMoves,
-        };
+        const int kingPos    = _board.GetKingMsbPos(_board.MovingColor);
+        const int checkerPos = ExtractMsbPos(_info.Checkers);
 
-        const int color          = MapT::GetColor();
-        const int enemyColor     = SwapColor(color);
-        const uint64_t enemyKing = _board.BitBoards[enemyColor * Board::BitBoardsPerCol + kingIndex];
-        auto func                = moveGenerators[targetBitBoardIndex - color * Board::BitBoardsPerCol];
-        const uint64_t moves     = func(msbPos, fullMap, 0);
+        if (const uint64_t kingRookLines = RookMap::GetMoves(kingPos, _info.FullMap);
+            (kingRookLines & _info.Checkers) != 0)
+            return (kingRookLines & RookMap::GetMoves(checkerPos, _info.FullMap)) | _info.Checkers;
 
-        return (enemyKing & moves) != 0;
+        const uint64_t kingBishopLines = BishopMap::GetMoves(kingPos, _info.FullMap);
+        return (kingBishopLines & BishopMap::GetMoves(checkerPos, _info.FullMap)) | _info.Checkers;
     }
 
-    template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval>
+    // returns own figures standing alone between own sliding figure and the enemy king
+    [[nodiscard]] uint64_t _getDiscoveringFigures(int enemyKingMsbPos, uint64_t fullMap) const;
+
+    // returns fields from which given figure type attacks the enemy king, prepared once per generator
+    [[nodiscard]] const std::array<uint64_t, Board::BitBoardsPerCol> &_getCheckFields();
+
+    template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval, bool GenOnlyQuietMoves>
     void _noCheckGen(payload &results, uint64_t fullMap, uint64_t blockedFigMap);
 
-    template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval>
+    template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval, bool GenOnlyQuietMoves>
     void _singleCheckGen(payload &results, uint64_t fullMap, uint64_t blockedFigMap, int checkType);
 
-    template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval>
+    template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval, bool GenOnlyQuietMoves>
     void _doubleCheckGen(payload &results, uint64_t blockedFigMap) const;
 
-    template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval, class MapT, bool isCheck = false>
+    template <
+        bool GenOnlyAttackMoves, bool ApplyHeuristicEval, bool GenOnlyQuietMoves, class MapT, bool isCheck = false>
     void _processPawnMoves(
         payload &results, uint64_t pawnAttacks, uint64_t enemyMap, uint64_t allyMap, uint64_t pinnedFigMap,
         [[maybe_unused]] uint64_t allowedMoveFilter = 0
@@ -125,8 +169,8 @@ struct MoveGenerator : ChessMechanics
     // TODO: Compare with simple if searching loop
     // TODO: propagate checkForCastling?
     template <
-        bool GenOnlyAttackMoves, bool ApplyHeuristicEval, class MapT, bool checkForCastling = false,
-        bool promotePawns = false, bool selectFigures = false, bool isCheck = false,
+        bool GenOnlyAttackMoves, bool ApplyHeuristicEval, bool GenOnlyQuietMoves, class MapT,
+        bool checkForCastling = false, bool promotePawns = false, bool selectFigures = false, bool isCheck = false,
         uint64_t (*elPassantFieldDeducer)(uint64_t, uint64_t) = nullptr>
     void _processFigMoves(
         payload &results, uint64_t pawnAttacks, uint64_t enemyMap, uint64_t allyMap, uint64_t pinnedFigMap,
@@ -139,17 +183,17 @@ struct MoveGenerator : ChessMechanics
         uint64_t (*elPassantFieldDeducer)(uint64_t, uint64_t) = nullptr>
     void _processNonAttackingMoves(
         payload &results, uint64_t pawnAttacks, uint64_t nonAttackingMoves, size_t figBoardIndex, uint64_t startField,
-        std::bitset<Board::CastlingCount + 1> castlings, uint64_t fullMap
+        std::bitset<Board::CastlingCount + 1> castlings
     ) const;
 
     template <class MapT, bool ApplyHeuristicEval, bool promotePawns>
     void _processAttackingMoves(
         payload &results, uint64_t pawnAttacks, uint64_t attackingMoves, size_t figBoardIndex, uint64_t startField,
-        std::bitset<Board::CastlingCount + 1> castlings, uint64_t fullMap
+        std::bitset<Board::CastlingCount + 1> castlings
     ) const;
 
     // TODO: test copying all old castlings
-    template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval>
+    template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval, bool GenOnlyQuietMoves>
     void _processPlainKingMoves(payload &results, uint64_t blockedFigMap, uint64_t allyMap, uint64_t enemyMap) const;
 
     // TODO: simplify ifs??
@@ -174,12 +218,35 @@ struct MoveGenerator : ChessMechanics
     const HistoricTable &_hTable;
     int _ply;
     int _mostRecentSq;
+
+    // Occupancy, attacks, checks and pins of the position, collected once per generator
+    const PositionInfo _info;
+
+    // Only figures placed on these fields are processed, used to generate moves of a single figure
+    static constexpr uint64_t AllFigures = ~static_cast<uint64_t>(0);
+    uint64_t _figureFilter               = AllFigures;
+
+    // Allowed quiet move targets per figure type and figures allowed to move anywhere except their blocked line,
+    // used to generate quiet checks only
+    static constexpr uint64_t AllFields = ~static_cast<uint64_t>(0);
+    std::array<uint64_t, Board::BitBoardsPerCol> _quietMovesFilter{
+        AllFields, AllFields, AllFields, AllFields, AllFields, AllFields
+    };
+    uint64_t _discoveringFigures{};
+
+    // Fields attacking the enemy king directly per figure type, computed lazily by _getCheckFields
+    std::array<uint64_t, Board::BitBoardsPerCol> _checkFields{};
+    bool _areCheckFieldsReady{};
 };
 
-template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval> MoveGenerator::payload MoveGenerator::GetMovesFast()
+template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval, bool GenOnlyQuietMoves>
+MoveGenerator::payload MoveGenerator::GetMovesFast()
 {
-    const uint64_t fullMap                             = GetFullBitMap();
-    const auto [blockedFigMap, checksCount, checkType] = GetBlockedFieldBitMap(fullMap);
+    static_assert(!(GenOnlyAttackMoves && GenOnlyQuietMoves), "Attack and quiet only generation are exclusive!");
+
+    const uint64_t fullMap       = _info.FullMap;
+    const uint64_t blockedFigMap = _info.BlockedFields;
+    const uint8_t checksCount    = _info.ChecksCount;
 
     TraceIfFalse(blockedFigMap != 0, "Blocked fig map must at least contains fields controlled by king!");
     TraceIfFalse(
@@ -192,13 +259,15 @@ template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval> MoveGenerator::paylo
     switch (checksCount)
     {
     case 0:
-        _noCheckGen<GenOnlyAttackMoves, ApplyHeuristicEval>(results, fullMap, blockedFigMap);
+        _noCheckGen<GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves>(results, fullMap, blockedFigMap);
         break;
     case 1:
-        _singleCheckGen<GenOnlyAttackMoves, ApplyHeuristicEval>(results, fullMap, blockedFigMap, checkType);
+        _singleCheckGen<GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves>(
+            results, fullMap, blockedFigMap, _info.CheckType
+        );
         break;
     case 2:
-        _doubleCheckGen<GenOnlyAttackMoves, ApplyHeuristicEval>(results, blockedFigMap);
+        _doubleCheckGen<GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves>(results, blockedFigMap);
         break;
 #ifndef NDEBUG
     default:
@@ -209,58 +278,78 @@ template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval> MoveGenerator::paylo
     return results;
 }
 
-template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval>
-void MoveGenerator::_noCheckGen(payload &results, const uint64_t fullMap, const uint64_t blockedFigMap)
+template <bool ApplyHeuristicEval> MoveGenerator::payload MoveGenerator::GetFigureMovesFast(const int msbPos)
 {
-    TraceIfFalse(fullMap != 0, "Full map is empty!");
+    // avoid any work when there is no figure of the moving side, empty fields hold the sentinel index of no color
+    if (_board.GetPieceOnSquare(msbPos) / Board::BitBoardsPerCol != static_cast<size_t>(_board.MovingColor))
+        return _threadStack.GetPayload();
 
-    [[maybe_unused]] const auto [pinnedFigsMap, _] =
-        GetPinnedFigsMap<ChessMechanics::PinnedFigGen::WoutAllowedTiles>(_board.MovingColor, fullMap);
+    _figureFilter        = MaxMsbPossible >> msbPos;
+    const payload result = GetMovesFast<false, ApplyHeuristicEval>();
+    _figureFilter        = AllFigures;
 
-    const uint64_t enemyMap = GetColBitMap(SwapColor(_board.MovingColor));
-    const uint64_t allyMap  = GetColBitMap(_board.MovingColor);
+    return result;
+}
 
-    const uint64_t pawnAttacks =
-        _board.MovingColor == WHITE
-            ? BlackPawnMap::GetAttackFields(
-                  _board.BitBoards[Board::BitBoardsPerCol * SwapColor(_board.MovingColor) + pawnsIndex]
-              )
-            : WhitePawnMap::GetAttackFields(
-                  _board.BitBoards[Board::BitBoardsPerCol * SwapColor(_board.MovingColor) + pawnsIndex]
-              );
+template <bool ApplyHeuristicEval> MoveGenerator::payload MoveGenerator::GetQuietChecksFast()
+{
+    TraceIfFalse(!IsCheck(), "Quiet checks must not be generated when the king is checked!");
+
+    _quietMovesFilter = _getCheckFields();
+    _discoveringFigures =
+        _getDiscoveringFigures(_board.GetKingMsbPos(SwapColor(_board.MovingColor)), _info.FullMap);
+    const payload result = GetMovesFast<false, ApplyHeuristicEval, true>();
+    _quietMovesFilter    = {AllFields, AllFields, AllFields, AllFields, AllFields, AllFields};
+    _discoveringFigures  = 0;
+
+    return result;
+}
 
-    _processFigMoves<GenOnlyAttackMoves, ApplyHeuristicEval, KnightMap>(
+template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval, bool GenOnlyQuietMoves>
+void MoveGenerator::_noCheckGen(payload &results, const uint64_t fullMap, const uint64_t blockedFigMap)
+{
+    TraceIfFalse(fullMap != 0, "Full map is empty!");
+
+    const uint64_t pinnedFigsMap = _info.PinnedFigs;
+    const uint64_t enemyMap      = _info.ColorMaps[SwapColor(_board.MovingColor)];
+    const uint64_t allyMap       = _info.ColorMaps[_board.MovingColor];
+    const uint64_t pawnAttacks   = _info.Attacks[SwapColor(_board.MovingColor)][pawnsIndex];
+
+    _processFigMoves<GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves, KnightMap>(
         results, pawnAttacks, enemyMap, allyMap, pinnedFigsMap
     );
 
-    _processFigMoves<GenOnlyAttackMoves, ApplyHeuristicEval, BishopMap>(
+    _processFigMoves<GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves, BishopMap>(
         results, pawnAttacks, enemyMap, allyMap, pinnedFigsMap
     );
 
-    _processFigMoves<GenOnlyAttackMoves, ApplyHeuristicEval, RookMap, true>(
+    _processFigMoves<GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves, RookMap, true>(
         results, pawnAttacks, enemyMap, allyMap, pinnedFigsMap
     );
 
-    _processFigMoves<GenOnlyAttackMoves, ApplyHeuristicEval, QueenMap>(
+    _processFigMoves<GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves, QueenMap>(
         results, pawnAttacks, enemyMap, allyMap, pinnedFigsMap
     );
 
     if (_board.MovingColor == WHITE)
-        _processPawnMoves<GenOnlyAttackMoves, ApplyHeuristicEval, WhitePawnMap>(
+        _processPawnMoves<GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves, WhitePawnMap>(
             results, pawnAttacks, enemyMap, allyMap, pinnedFigsMap
         );
     else
-        _processPawnMoves<GenOnlyAttackMoves, ApplyHeuristicEval, BlackPawnMap>(
+        _processPawnMoves<GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves, BlackPawnMap>(
             results, pawnAttacks, enemyMap, allyMap, pinnedFigsMap
         );
 
-    _processPlainKingMoves<GenOnlyAttackMoves, ApplyHeuristicEval>(results, blockedFigMap, allyMap, enemyMap);
+    _processPlainKingMoves<GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves>(
+        results, blockedFigMap, allyMap, enemyMap
+    );
 
     if constexpr (!GenOnlyAttackMoves)
-        _processKingCastlings<ApplyHeuristicEval>(results, blockedFigMap, fullMap);
+        if ((_board.BitBoards[_board.MovingColor * Board::BitBoardsPerCol + kingIndex] & _figureFilter) != 0)
+            _processKingCastlings<ApplyHeuristicEval>(results, blockedFigMap, fullMap);
 }
 
-template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval>
+template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval, bool GenOnlyQuietMoves>
 void MoveGenerator::_singleCheckGen(
     payload &results, const uint64_t fullMap, const uint64_t blockedFigMap, const int checkType
 )
@@ -270,68 +359,61 @@ void MoveGenerator::_singleCheckGen(
 
     static constexpr uint64_t UNUSED = 0;
 
-    // simplifying figure search by distinguishing check types
-    const auto [pinnedFigsMap, allowedTilesMap] = [&]() -> std::pair<uint64_t, uint64_t>
-    {
-        if (checkType == slidingFigCheck)
-            return GetPinnedFigsMap<ChessMechanics::PinnedFigGen::WAllowedTiles>(_board.MovingColor, fullMap);
-
-        [[maybe_unused]] const auto [pinnedFigsMap, _] =
-            GetPinnedFigsMap<ChessMechanics::PinnedFigGen::WoutAllowedTiles>(_board.MovingColor, fullMap);
-        return {pinnedFigsMap, GetAllowedTilesWhenCheckedByNonSliding()};
-    }();
+    // simplifying figure search by distinguishing check types, simple figure check can be only captured
+    const uint64_t allowedTilesMap = checkType == slidingFigCheck ? _getCheckBlockingFields() : _info.Checkers;
 
     // helping variable preparation
-    const uint64_t enemyMap = GetColBitMap(SwapColor(_board.MovingColor));
-    const uint64_t allyMap  = GetColBitMap(_board.MovingColor);
-
-    const uint64_t pawnAttacks =
-        _board.MovingColor == WHITE
-            ? BlackPawnMap::GetAttackFields(
-                  _board.BitBoards[Board::BitBoardsPerCol * SwapColor(_board.MovingColor) + pawnsIndex]
-              )
-            : WhitePawnMap::GetAttackFields(
-                  _board.BitBoards[Board::BitBoardsPerCol * SwapColor(_board.MovingColor) + pawnsIndex]
-              );
+    const uint64_t pinnedFigsMap = _info.PinnedFigs;
+    const uint64_t enemyMap      = _info.ColorMaps[SwapColor(_board.MovingColor)];
+    const uint64_t allyMap       = _info.ColorMaps[_board.MovingColor];
+    const uint64_t pawnAttacks   = _info.Attacks[SwapColor(_board.MovingColor)][pawnsIndex];
 
     // Specific figure processing
-    _processFigMoves<GenOnlyAttackMoves, ApplyHeuristicEval, KnightMap, false, false, false, true>(
+    _processFigMoves<
+        GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves, KnightMap, false, false, false, true>(
         results, pawnAttacks, enemyMap, allyMap, pinnedFigsMap, UNUSED, allowedTilesMap
     );
 
-    _processFigMoves<GenOnlyAttackMoves, ApplyHeuristicEval, BishopMap, false, false, false, true>(
+    _processFigMoves<
+        GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves, BishopMap, false, false, false, true>(
         results, pawnAttacks, enemyMap, allyMap, pinnedFigsMap, UNUSED, allowedTilesMap
     );
 
-    _processFigMoves<GenOnlyAttackMoves, ApplyHeuristicEval, RookMap, true, false, false, true>(
+    _processFigMoves<
+        GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves, RookMap, true, false, false, true>(
         results, pawnAttacks, enemyMap, allyMap, pinnedFigsMap, UNUSED, allowedTilesMap
     );
 
-    _processFigMoves<GenOnlyAttackMoves, ApplyHeuristicEval, QueenMap, false, false, false, true>(
+    _processFigMoves<
+        GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves, QueenMap, false, false, false, true>(
         results, pawnAttacks, enemyMap, allyMap, pinnedFigsMap, UNUSED, allowedTilesMap
     );
 
     if (_board.MovingColor == WHITE)
-        _processPawnMoves<GenOnlyAttackMoves, ApplyHeuristicEval, WhitePawnMap, true>(
+        _processPawnMoves<GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves, WhitePawnMap, true>(
             results, pawnAttacks, enemyMap, allyMap, pinnedFigsMap, allowedTilesMap
         );
     else
-        _processPawnMoves<GenOnlyAttackMoves, ApplyHeuristicEval, BlackPawnMap, true>(
+        _processPawnMoves<GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves, BlackPawnMap, true>(
             results, pawnAttacks, enemyMap, allyMap, pinnedFigsMap, allowedTilesMap
         );
 
-    _processPlainKingMoves<GenOnlyAttackMoves, ApplyHeuristicEval>(results, blockedFigMap, allyMap, enemyMap);
+    _processPlainKingMoves<GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves>(
+        results, blockedFigMap, allyMap, enemyMap
+    );
 }
 
-template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval>
+template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval, bool GenOnlyQuietMoves>
 void MoveGenerator::_doubleCheckGen(payload &results, const uint64_t blockedFigMap) const
 {
-    const uint64_t allyMap  = GetColBitMap(_board.MovingColor);
-    const uint64_t enemyMap = GetColBitMap(SwapColor(_board.MovingColor));
-    _processPlainKingMoves<GenOnlyAttackMoves, ApplyHeuristicEval>(results, blockedFigMap, allyMap, enemyMap);
+    const uint64_t allyMap  = _info.ColorMaps[_board.MovingColor];
+    const uint64_t enemyMap = _info.ColorMaps[SwapColor(_board.MovingColor)];
+    _processPlainKingMoves<GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves>(
+        results, blockedFigMap, allyMap, enemyMap
+    );
 }
 
-template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval, class MapT, bool isCheck>
+template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval, bool GenOnlyQuietMoves, class MapT, bool isCheck>
 void MoveGenerator::_processPawnMoves(
     payload &results, const uint64_t pawnAttacks, const uint64_t enemyMap, const uint64_t allyMap,
     const uint64_t pinnedFigMap, const uint64_t allowedMoveFilter
@@ -341,13 +423,18 @@ void MoveGenerator::_processPawnMoves(
     const uint64_t nonPromotingPawns = _board.BitBoards[MapT::GetBoardIndex(0)] ^ promotingPawns;
 
     _processFigMoves<
-        GenOnlyAttackMoves, ApplyHeuristicEval, MapT, false, false, true, isCheck, MapT::GetElPassantField>(
+        GenOnlyAttackMoves, ApplyHeuristicEval, GenOnlyQuietMoves, MapT, false, false, true, isCheck,
+        MapT::GetElPassantField>(
         results, pawnAttacks, enemyMap, allyMap, pinnedFigMap, nonPromotingPawns, allowedMoveFilter
     );
 
+    // promotions and el passant are treated as attack moves
+    if constexpr (GenOnlyQuietMoves)
+        return;
+
     // During quiesce search we should also check all promotions so GenOnlyAttackMoves is false
     if (promotingPawns)
-        _processFigMoves<false, ApplyHeuristicEval, MapT, false, true, true, isCheck>(
+        _processFigMoves<false, ApplyHeuristicEval, false, MapT, false, true, true, isCheck>(
             results, pawnAttacks, enemyMap, allyMap, pinnedFigMap, promotingPawns, allowedMoveFilter
         );
 
@@ -370,7 +457,7 @@ void MoveGenerator::_processElPassantMoves(
     const uint64_t suspectedFields = MapT::GetElPassantSuspectedFields(_board.ElPassantField);
     const size_t enemyCord         = SwapColor(_board.MovingColor) * Board::BitBoardsPerCol;
     const uint64_t enemyRookFigs = _board.BitBoards[enemyCord + queensIndex] | _board.BitBoards[enemyCord + rooksIndex];
-    uint64_t possiblePawnsToMove = _board.BitBoards[MapT::GetBoardIndex(0)] & suspectedFields;
+    uint64_t possiblePawnsToMove = _board.BitBoards[MapT::GetBoardIndex(0)] & suspectedFields & _figureFilter;
 
     while (possiblePawnsToMove)
     {
@@ -426,9 +513,6 @@ void MoveGenerator::_processElPassantMoves(
         mv.SetCasltingRights(_board.Castlings);
         mv.SetMoveType(PackedMove::CaptureFlag);
 
-        if (_isPawnGivingCheck<MapT>(moveMap))
-            mv.SetCheckType();
-
         // preparing heuristic evaluation
 
         if constexpr (ApplyHeuristicEval)
@@ -445,8 +529,8 @@ void MoveGenerator::_processElPassantMoves(
 }
 
 template <
-    bool GenOnlyAttackMoves, bool ApplyHeuristicEval, class MapT, bool checkForCastling, bool promotePawns,
-    bool selectFigures, bool isCheck, uint64_t (*elPassantFieldDeducer)(uint64_t, uint64_t)>
+    bool GenOnlyAttackMoves, bool ApplyHeuristicEval, bool GenOnlyQuietMoves, class MapT, bool checkForCastling,
+    bool promotePawns, bool selectFigures, bool isCheck, uint64_t (*elPassantFieldDeducer)(uint64_t, uint64_t)>
 void MoveGenerator::_processFigMoves(
     payload &results, const uint64_t pawnAttacks, const uint64_t enemyMap, const uint64_t allyMap,
     const uint64_t pinnedFigMap, const uint64_t figureSelector, const uint64_t allowedMoveSelector
@@ -456,8 +540,9 @@ void MoveGenerator::_processFigMoves(
     TraceIfFalse(allyMap != 0, "Ally map is empty!");
 
     const uint64_t fullMap = enemyMap | allyMap;
-    uint64_t pinnedOnes    = pinnedFigMap & _board.BitBoards[MapT::GetBoardIndex(_board.MovingColor)];
-    uint64_t unpinnedOnes  = _board.BitBoards[MapT::GetBoardIndex(_board.MovingColor)] ^ pinnedOnes;
+    const uint64_t figures = _board.BitBoards[MapT::GetBoardIndex(_board.MovingColor)] & _figureFilter;
+    uint64_t pinnedOnes    = pinnedFigMap & figures;
+    uint64_t unpinnedOnes  = figures ^ pinnedOnes;
 
     // applying filter if needed
     if constexpr (selectFigures)
@@ -490,21 +575,23 @@ void MoveGenerator::_processFigMoves(
             updatedCastlings[RookMap::GetMatchingCastlingIndex(_board, figBoard)] = false;
 
         // preparing moves
-        const uint64_t attackMoves                        = figMoves & enemyMap;
-        [[maybe_unused]] const uint64_t nonAttackingMoves = figMoves ^ attackMoves;
+        const uint64_t attackMoves = figMoves & enemyMap;
+        [[maybe_unused]] const uint64_t nonAttackingMoves =
+            (figMoves ^ attackMoves) & _getQuietMovesFilter(MapT::GetBoardIndex(_board.MovingColor), figBoard);
 
         // processing move consequences
 
         if constexpr (!GenOnlyAttackMoves)
             _processNonAttackingMoves<MapT, ApplyHeuristicEval, promotePawns, elPassantFieldDeducer>(
                 results, pawnAttacks, nonAttackingMoves, MapT::GetBoardIndex(_board.MovingColor), figBoard,
-                updatedCastlings, fullMap
+                updatedCastlings
             );
 
-        _processAttackingMoves<MapT, ApplyHeuristicEval, promotePawns>(
-            results, pawnAttacks, attackMoves, MapT::GetBoardIndex(_board.MovingColor), figBoard, updatedCastlings,
-            fullMap
-        );
+        if constexpr (!GenOnlyQuietMoves)
+            _processAttackingMoves<MapT, ApplyHeuristicEval, promotePawns>(
+                results, pawnAttacks, attackMoves, MapT::GetBoardIndex(_board.MovingColor), figBoard,
+                updatedCastlings
+            );
 
         unpinnedOnes ^= figBoard;
     }
@@ -526,22 +613,24 @@ void MoveGenerator::_processFigMoves(
         // TODO: breaking if there?
 
         // preparing moves
-        const uint64_t attackMoves                        = figMoves & enemyMap;
-        [[maybe_unused]] const uint64_t nonAttackingMoves = figMoves ^ attackMoves;
+        const uint64_t attackMoves = figMoves & enemyMap;
+        [[maybe_unused]] const uint64_t nonAttackingMoves =
+            (figMoves ^ attackMoves) & _getQuietMovesFilter(MapT::GetBoardIndex(_board.MovingColor), figBoard);
 
         // processing move consequences
 
         if constexpr (!GenOnlyAttackMoves)
             _processNonAttackingMoves<MapT, ApplyHeuristicEval, promotePawns, elPassantFieldDeducer>(
                 results, pawnAttacks, nonAttackingMoves, MapT::GetBoardIndex(_board.MovingColor), figBoard,
-                _board.Castlings, fullMap
+                _board.Castlings
             );
 
         // TODO: There is exactly one move possible
-        _processAttackingMoves<MapT, ApplyHeuristicEval, promotePawns>(
-            results, pawnAttacks, attackMoves, MapT::GetBoardIndex(_board.MovingColor), figBoard, _board.Castlings,
-            fullMap
-        );
+        if constexpr (!GenOnlyQuietMoves)
+            _processAttackingMoves<MapT, ApplyHeuristicEval, promotePawns>(
+                results, pawnAttacks, attackMoves, MapT::GetBoardIndex(_board.MovingColor), figBoard,
+                _board.Castlings
+            );
 
         pinnedOnes ^= figBoard;
     }
@@ -550,7 +639,7 @@ void MoveGenerator::_processFigMoves(
 template <class MapT, bool ApplyHeuristicEval, bool promotePawns, uint64_t (*elPassantFieldDeducer)(uint64_t, uint64_t)>
 void MoveGenerator::_processNonAttackingMoves(
     payload &results, const uint64_t pawnAttacks, uint64_t nonAttackingMoves, const size_t figBoardIndex,
-    const uint64_t startField, const std::bitset<Board::CastlingCount + 1> castlings, const uint64_t fullMap
+    const uint64_t startField, const std::bitset<Board::CastlingCount + 1> castlings
 ) const
 {
     TraceIfFalse(figBoardIndex < Board::BitBoardsCount, "Invalid figure board index!");
@@ -573,11 +662,6 @@ void MoveGenerator::_processNonAttackingMoves(
             mv.SetTargetBoardIndex(figBoardIndex);
             mv.SetKilledBoardIndex(Board::SentinelBoardIndex);
 
-            if ((figBoardIndex == wPawnsIndex && _isPawnGivingCheck<WhitePawnMap>(moveBoard)) ||
-                (figBoardIndex == bPawnsIndex && _isPawnGivingCheck<BlackPawnMap>(moveBoard)) ||
-                _isGivingCheck<MapT>(movePos, fullMap, SwapColor(figBoardIndex > wKingIndex)))
-                mv.SetCheckType();
-
             // if el passant line is passed when a figure moved to these line flags will turn on
             if constexpr (elPassantFieldDeducer != nullptr)
             {
@@ -624,9 +708,6 @@ void MoveGenerator::_processNonAttackingMoves(
                 mv.SetCasltingRights(castlings);
                 mv.SetMoveType(PackedMove::PromoFlag | PromoFlags[i]);
 
-                if (_isPromotingPawnGivingCheck<MapT>(movePos, fullMap, TargetBoard))
-                    mv.SetCheckType();
-
                 // preparing heuristic eval info
                 if constexpr (ApplyHeuristicEval)
                 {
@@ -646,7 +727,7 @@ void MoveGenerator::_processNonAttackingMoves(
 template <class MapT, bool ApplyHeuristicEval, bool promotePawns>
 void MoveGenerator::_processAttackingMoves(
     payload &results, const uint64_t pawnAttacks, uint64_t attackingMoves, const size_t figBoardIndex,
-    const uint64_t startField, const std::bitset<Board::CastlingCount + 1> castlings, const uint64_t fullMap
+    const uint64_t startField, const std::bitset<Board::CastlingCount + 1> castlings
 ) const
 {
     TraceIfFalse(figBoardIndex < Board::BitBoardsCount, "Invalid figure board index!");
@@ -656,7 +737,7 @@ void MoveGenerator::_processAttackingMoves(
         // extracting moves
         const int movePos                  = ExtractMsbPos(attackingMoves);
         const uint64_t moveBoard           = MaxMsbPossible >> movePos;
-        const size_t attackedFigBoardIndex = GetIndexOfContainingBitBoard(moveBoard, SwapColor(_board.MovingColor));
+        const size_t attackedFigBoardIndex = _board.GetPieceOnSquare(movePos);
 
         if constexpr (!promotePawns)
         // simple figure case
@@ -674,11 +755,6 @@ void MoveGenerator::_processAttackingMoves(
             mv.SetCasltingRights(castlings);
             mv.SetMoveType(PackedMove::CaptureFlag);
 
-            if ((figBoardIndex == wPawnsIndex && _isPawnGivingCheck<WhitePawnMap>(moveBoard)) ||
-                (figBoardIndex == bPawnsIndex && _isPawnGivingCheck<BlackPawnMap>(moveBoard)) ||
-                _isGivingCheck<MapT>(movePos, fullMap, SwapColor(figBoardIndex > wKingIndex)))
-                mv.SetCheckType();
-
             // preparing heuristic eval info
             if constexpr (ApplyHeuristicEval)
             {
@@ -711,9 +787,6 @@ void MoveGenerator::_processAttackingMoves(
                 mv.SetCasltingRights(castlings);
                 mv.SetMoveType(PackedMove::CaptureFlag | PackedMove::PromoFlag | PromoFlags[i]);
 
-                if (_isPromotingPawnGivingCheck<MapT>(movePos, fullMap, targetBoard))
-                    mv.SetCheckType();
-
                 // preparing heuristic eval info
 
                 if constexpr (ApplyHeuristicEval)
@@ -733,7 +806,7 @@ void MoveGenerator::_processAttackingMoves(
     }
 }
 
-template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval>
+template <bool GenOnlyAttackMoves, bool ApplyHeuristicEval, bool GenOnlyQuietMoves>
 void MoveGenerator::_processPlainKingMoves(
     payload &results, const uint64_t blockedFigMap, const uint64_t allyMap, const uint64_t enemyMap
 ) const
@@ -741,12 +814,17 @@ void MoveGenerator::_processPlainKingMoves(
     TraceIfFalse(allyMap != 0, "Ally map is empty!");
     TraceIfFalse(enemyMap != 0, "Enemy map is empty!");
 
+    if ((_board.BitBoards[_board.MovingColor * Board::BitBoardsPerCol + kingIndex] & _figureFilter) == 0)
+        return;
+
     static constexpr size_t CastlingPerColor = 2;
 
     // generating moves
     const uint64_t kingMoves = KingMap::GetMoves(_board.GetKingMsbPos(_board.MovingColor)) & ~blockedFigMap & ~allyMap;
     uint64_t attackingMoves  = kingMoves & enemyMap;
-    [[maybe_unused]] uint64_t nonAttackingMoves = kingMoves ^ attackingMoves;
+    [[maybe_unused]] uint64_t nonAttackingMoves =
+        (kingMoves ^ attackingMoves) &
+        _getQuietMovesFilter(kingIndex, _board.BitBoards[_board.MovingColor * Board::BitBoardsPerCol + kingIndex]);
 
     // preparing variables
     auto castlings                                                        = _board.Castlings;
@@ -787,6 +865,9 @@ void MoveGenerator::_processPlainKingMoves(
             nonAttackingMoves ^= (MaxMsbPossible >> newPos);
         }
 
+    if constexpr (GenOnlyQuietMoves)
+        return;
+
     // processing slightly more complicated attacking moves
     while (attackingMoves)
     {
@@ -795,7 +876,7 @@ void MoveGenerator::_processPlainKingMoves(
         const uint64_t newKingBoard = MaxMsbPossible >> newPos;
 
         // finding an attacked figure
-        const size_t attackedFigBoardIndex = GetIndexOfContainingBitBoard(newKingBoard, SwapColor(_board.MovingColor));
+        const size_t attackedFigBoardIndex = _board.GetPieceOnSquare(newPos);
 
         Move mv{};
 
@@ -836,7 +917,8 @@ void MoveGenerator::_processKingCastlings(payload &results, const uint64_t block
             (Board::CastlingsRookMaps[castlingIndex] &
              _board.BitBoards[_board.MovingColor * Board::BitBoardsPerCol + rooksIndex]) != 0 &&
             (Board::CastlingSensitiveFields[castlingIndex] & blockedFigMap) == 0 &&
-            (Board::CastlingTouchedFields[castlingIndex] & fullMap) == 0)
+            (Board::CastlingTouchedFields[castlingIndex] & fullMap) == 0 &&
+            (Board::CastlingNewRookMaps[castlingIndex] & _quietMovesFilter[rooksIndex]) != 0)
         {
             auto castlings                                                                = _board.Castlings;
             castlings[_board.MovingColor * Board::CastlingsPerColor + KingCastlingIndex]  = false;
@@ -0,0 +1,106 @@
+//
+// Created by Jlisowskyy on 10/17/26.
+//
+
+#ifndef PERFTTABLE_H
+#define PERFTTABLE_H
+
+#include <atomic>
+#include <memory>
+
+#include "../CompilationConstants.h"
+#include "../EngineUtils.h"
+
+/*
+ *      Class used to cache results of perft subtrees, maps (zobrist hash, depth) pairs to the number of leaves below
+ *      given position. Table is shared by all perft workers and is lock-free. Every entry stores the key xored with
+ *      the data, so entries torn by concurrent writes are simply detected as misses.
+ *
+ *      Resources: https://www.chessprogramming.org/Perft#Hashing
+ */
+
+class PerftTable
+{
+    public:
+    // ------------------------------
+    // Class creation
+    // ------------------------------
+
+    PerftTable()  = default;
+    ~PerftTable() = default;
+
+    PerftTable(PerftTable &&)      = delete;
+    PerftTable(const PerftTable &) = delete;
+
+    PerftTable &operator=(const PerftTable &) = delete;
+    PerftTable &operator=(PerftTable &&)      = delete;
+
+    // ------------------------------
+    // Class interaction
+    // ------------------------------
+
+    // allocates the table with size rounded down to the power of two, size 0 disables the table
+    void Resize(const size_t sizeMB)
+    {
+        _entries.reset();
+        _mask = 0;
+
+        if (sizeMB == 0)
+            return;
+
+        size_t entryCount = 1;
+        while (2 * entryCount * sizeof(_entry_t) <= sizeMB * MB) entryCount *= 2;
+
+        _entries = std::make_unique<_entry_t[]>(entryCount);
+        _mask    = entryCount - 1;
+    }
+
+    [[nodiscard]] bool IsEnabled() const { return _entries != nullptr; }
+
+    // returns true and fills the count when the subtree of given depth was already counted
+    [[nodiscard]] INLINE bool Probe(const uint64_t hash, const int depth, uint64_t &count) const
+    {
+        const _entry_t &entry = _entries[hash & _mask];
+        const uint64_t data   = entry.Data.load(std::memory_order_relaxed);
+        const uint64_t key    = entry.KeyXorData.load(std::memory_order_relaxed) ^ data;
+
+        if (key != hash || static_cast<int>(data & DepthMask) != depth)
+            return false;
+
+        count = data >> DepthBits;
+        return true;
+    }
+
+    // always replaces the previous entry
+    INLINE void Store(const uint64_t hash, const int depth, const uint64_t count)
+    {
+        _entry_t &entry     = _entries[hash & _mask];
+        const uint64_t data = count << DepthBits | static_cast<uint64_t>(depth);
+
+        entry.KeyXorData.store(hash ^ data, std::memory_order_relaxed);
+        entry.Data.store(data, std::memory_order_relaxed);
+    }
+
+    private:
+    // ------------------------------
+    // Inner types
+    // ------------------------------
+
+    struct _entry_t
+    {
+        std::atomic<uint64_t> KeyXorData{};
+        std::atomic<uint64_t> Data{};
+    };
+
+    // ------------------------------
+    // Class fields
+    // ------------------------------
+
+    static constexpr uint64_t DepthBits = 8;
+    static constexpr uint64_t DepthMask = (1ULL << DepthBits) - 1;
+
+    std::unique_ptr<_entry_t[]> _entries{};
+    size_t _mask{};
+};
+
+#endif // PERFTTABLE_H
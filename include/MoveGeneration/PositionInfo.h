@@ -0,0 +1,53 @@
+//
+// Created by Jlisowskyy on 10/17/26.
+//
+
+#ifndef POSITIONINFO_H
+#define POSITIONINFO_H
+
+#include <array>
+#include <cinttypes>
+
+#include "../Board.h"
+
+/*
+ *      Summary of the position built once per search node by ChessMechanics::GetPositionInfo. It is shared by the
+ *      move generation, SEE and the static evaluation, so none of them rebuilds occupancy, attacks or pins again.
+ *
+ *      Attack maps and pins are collected only for what the legal move generation needs: attacks of the side not to
+ *      move and pins of the moving side. Sliding figures attack through the opposite king, so the king can not
+ *      retreat along the attack line. Attacks of the moving side can be added by ChessMechanics::CollectAttacks.
+ */
+
+struct PositionInfo
+{
+    // ------------------------------
+    // Class interaction
+    // ------------------------------
+
+    [[nodiscard]] INLINE bool IsCheck() const { return ChecksCount != 0; }
+
+    // ------------------------------
+    // Class fields
+    // ------------------------------
+
+    // Occupancy of the whole board and of each color
+    uint64_t FullMap{};
+    std::array<uint64_t, 2> ColorMaps{};
+
+    // Fields attacked by every figure type, indexed by color, only the side not to move is filled by default
+    std::array<std::array<uint64_t, Board::BitBoardsPerCol>, 2> Attacks{};
+
+    // Union of all enemy attacks, fields on which the king of the moving side can not step
+    uint64_t BlockedFields{};
+
+    // Enemy figures attacking the king of the moving side
+    uint64_t Checkers{};
+    uint8_t ChecksCount{};
+    uint8_t CheckType{};
+
+    // Figures of the moving side pinned to its king
+    uint64_t PinnedFigs{};
+};
+
+#endif // POSITIONINFO_H
@@ -5,7 +5,11 @@
 #ifndef ROOKMAP_H
 #define ROOKMAP_H
 
+#include <type_traits>
+
+#include "../CompilationConstants.h"
 #include "../MapTypes/FancyMagicRookMap.h"
+#include "../MapTypes/PextMap.h"
 
 class RookMap
 {
@@ -13,7 +17,7 @@ class RookMap
     // Underlying map definition
     // -------------------------------
 
-    using _underlyingMap = FancyMagicRookMap;
+    using _underlyingMap = std::conditional_t<UsePextMaps, PextRookMap, FancyMagicRookMap>;
 
     public:
     // ---------------------------------------
@@ -5,14 +5,21 @@
 #ifndef BESTMOVESEARCH_H
 #define BESTMOVESEARCH_H
 
+#include <atomic>
 #include <map>
 
 #include "../EngineUtils.h"
 #include "../Evaluation/CounterMoveTable.h"
+#include "../Evaluation/EvalCache.h"
 #include "../Evaluation/HistoricTable.h"
 #include "../Evaluation/KillerTable.h"
+#include "../Evaluation/MaterialHashTable.h"
+#include "../Evaluation/PawnHashTable.h"
 #include "../Interface/Logger.h"
+#include "../MoveGeneration/PositionInfo.h"
+#include "../ThreadManagement/GameTimeManager.h"
 #include "../ThreadManagement/Stack.h"
+#include "TranspositionTable.h"
 
 /*
  * Class defines our search algorithm.
@@ -128,6 +135,31 @@ class BestMoveSearch
     };
 
     public:
+    /*
+     * Counter of nodes visited by single search thread. Every thread writes only to its own counter,
+     * main thread sums them up to display the nodes and nps of the whole search. Aligned to the cache line size
+     * to avoid false sharing between the threads.
+     * */
+
+    struct alignas(64) ThreadNodeCounter
+    {
+        std::atomic<uint64_t> Nodes{};
+    };
+
+    /*
+     * Evaluation tables used by single search thread. They are owned by the thread, outlive the searches
+     * and are shared by all of them, so the pawn, material and evaluation caches stay warm between the moves.
+     * */
+
+    struct EvalTables
+    {
+        explicit EvalTables(const size_t cacheSizeMB) : Cache(cacheSizeMB) {}
+
+        PawnHashTable Pawn{};
+        MaterialHashTable Material{};
+        EvalCache Cache;
+    };
+
     // ------------------------------
     // Class creation
     // ------------------------------
@@ -136,10 +168,33 @@ class BestMoveSearch
      * Construction needs a board as starting state of the search algorithm,
      * Stack as a container to store moves and age to use inside the TT replacement scheme.
      *
+     * When used inside the Lazy SMP search, 'threadInd' identifies the thread, 'counters' points to the array of
+     * 'threadCount' node counters shared by all threads. Thread with index 0 is the main one, others are helpers,
+     * which skip some iterations of the iterative deepening to diversify the search.
+     *
+     * 'evalTables' are the evaluation tables owned by the thread, nullptr disables all evaluation caching.
+     *
      * */
 
     BestMoveSearch() = delete;
-    BestMoveSearch(const Board &board, Stack<Move, DEFAULT_STACK_SIZE> &s) : _stack(s), _board(board) {}
+    BestMoveSearch(
+        const Board &board, Stack<Move, DEFAULT_STACK_SIZE> &s, const size_t threadInd = 0,
+        ThreadNodeCounter *counters = nullptr, const size_t threadCount = 1, EvalTables *evalTables = nullptr
+    )
+        : _stack(s), _board(board), _pawnTable(evalTables == nullptr ? nullptr : &evalTables->Pawn),
+          _materialTable(evalTables == nullptr ? nullptr : &evalTables->Material),
+          _evalCache(evalTables != nullptr && evalTables->Cache.IsEnabled() ? &evalTables->Cache : nullptr),
+          _threadInd(threadInd), _threadCount(counters == nullptr ? 1 : threadCount),
+          _nodeCounters(counters == nullptr ? &_ownCounter : counters)
+    {
+        // tables outlive the searches, but their statistics are reported per search
+        if (evalTables != nullptr)
+        {
+            evalTables->Pawn.ResetStatistics();
+            evalTables->Material.ResetStatistics();
+            evalTables->Cache.ResetStatistics();
+        }
+    }
     ~BestMoveSearch() = default;
 
     // ------------------------------
@@ -165,6 +220,9 @@ class BestMoveSearch
     int IterativeDeepening(PackedMove *bestMove, PackedMove *ponderMove, int maxDepth, bool writeInfo = true);
     int QuiesceEval();
 
+    /* Returns the depth of the last fully completed iteration of the iterative deepening */
+    [[nodiscard]] int GetCompletedDepth() const { return _completedDepth; }
+
     // ------------------------------
     // Private class methods
     // ------------------------------
@@ -175,13 +233,10 @@ class BestMoveSearch
 
     template <SearchType searchType, bool followPv>
     int _search(
-        int alpha, int beta, int depthLeft, int ply, uint64_t zHash, Move prevMove, PV &pv, PackedMove *bestMoveOut
+        int alpha, int beta, int depthLeft, int ply, Move prevMove, PV &pv, PackedMove *bestMoveOut
     );
 
-    template <SearchType searchType> int _qSearch(int alpha, int beta, int ply, uint64_t zHash, int extendedDepth);
-
-    static void _pullMoveToFront(Stack<Move, DEFAULT_STACK_SIZE>::StackPayload moves, PackedMove mv);
-    static void _fetchBestMove(Stack<Move, DEFAULT_STACK_SIZE>::StackPayload moves, size_t targetPos);
+    template <SearchType searchType> int _qSearch(int alpha, int beta, int ply, int extendedDepth);
 
     INLINE void _saveQuietMoveInfo(const Move mv, const Move prevMove, const int depth, const int ply)
     {
@@ -190,7 +245,42 @@ class BestMoveSearch
         _histTable.SetBonusMove(mv, depth);
     }
 
-    int _deduceExtensions(Move prevMove, Move actMove, int seeValue, bool isPv);
+    int _deduceExtensions(Move prevMove, Move actMove, bool isWinningCheck, bool isPv);
+
+    [[nodiscard]] static INLINE bool
+    _isTTCutoff(const TranspositionTable::HashRecord &record, const int alpha, const int beta)
+    {
+        const NodeType type = record.GetNodeType();
+        return type == PV_NODE || (type == LOWER_BOUND && record.GetEval() >= beta) ||
+               (type == UPPER_BOUND && record.GetEval() <= alpha);
+    }
+
+    INLINE void _countNode()
+    {
+        ++_visitedNodes;
+
+        // only the owning thread writes to the counter, so there is no need for the atomic read-modify-write
+        std::atomic<uint64_t> &nodes = _nodeCounters[_threadInd].Nodes;
+        const uint64_t count         = nodes.load(std::memory_order_relaxed) + 1;
+        nodes.store(count, std::memory_order_relaxed);
+
+        // every searcher watches the deadline on its own, so the stop lands within a bounded number of nodes
+        static_assert((TIME_CHECK_NODE_INTERVAL & (TIME_CHECK_NODE_INTERVAL - 1)) == 0);
+        if ((count & (TIME_CHECK_NODE_INTERVAL - 1)) == 0)
+            GameTimeManager::CheckDeadline();
+    }
+
+    /* Returns the sum of nodes visited by all threads taking part in the search */
+    [[nodiscard]] uint64_t _getTotalNodes() const;
+
+    /* Decides whether helper thread should skip given iteration to avoid searching the same tree as other threads */
+    [[nodiscard]] bool _shouldSkipDepth(int depth) const;
+
+    /* Moves statistics gathered by this thread, including the evaluation tables ones, into the TT statistics */
+    void _mergeStatistics();
+
+    /* Returns static eval of the current position from the moving color perspective, reusing the eval cache */
+    int _evaluate(uint64_t zHash, const PositionInfo &info);
 
     // ------------------------------
     // Class fields
@@ -205,9 +295,23 @@ class BestMoveSearch
     KillerTable _kTable{};
     CounterMoveTable _cmTable{};
     HistoricTable _histTable{};
+    PawnHashTable *_pawnTable;
+    MaterialHashTable *_materialTable;
+    EvalCache *_evalCache;
     int _maxPlyReached{};
     int _rootDepth{};
     PackedMove _excludedMove{};
+    int _completedDepth{};
+
+    // Lazy SMP components
+    size_t _threadInd;
+    size_t _threadCount;
+    ThreadNodeCounter _ownCounter{};
+    ThreadNodeCounter *_nodeCounters;
+
+    // TT statistics gathered by this thread, merged into the table ones at the end of each iteration
+    bool _collectTTStats{TTable.IsStatisticsEnabled()};
+    TranspositionTable::Statistics _ttStats{};
 };
 
 #endif // BESTMOVESEARCH_H
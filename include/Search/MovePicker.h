@@ -0,0 +1,302 @@
+//
+// Created by Jlisowskyy on 10/17/26.
+//
+
+#ifndef MOVEPICKER_H
+#define MOVEPICKER_H
+
+#include <utility>
+
+#include "../CompilationConstants.h"
+#include "../MoveGeneration/MoveGenerator.h"
+
+/*
+ *      Class used by the search to iterate over the moves of a node. Moves are generated lazily in stages,
+ *      so nodes that cut off early do not pay for generating and sorting moves that are never searched:
+ *
+ *      1) Hash move - validated by generating moves of the moved figure only
+ *      2) Good captures and promotions - ordered by MoveSortEval, filtered with SEE
+ *      3) Quiet moves - killers, counter move and the rest ordered by the history table (all through MoveSortEval)
+ *      4) Bad captures - captures that failed the SEE test in the second stage
+ *
+ *      When the king is checked all evasions are generated at once, as their count is small and is needed by
+ *      the search anyway. In quiesce mode only the hash move and the good captures are returned, optionally followed
+ *      by the quiet moves giving check.
+ *
+ *      Moves are picked by selecting the best remaining one on demand instead of sorting whole lists.
+ *      All generated payloads are popped from the stack on destruction.
+ *
+ *      Resources: https://www.chessprogramming.org/Move_Ordering#Staged_Move_Generation
+ */
+
+class MovePicker
+{
+    // ------------------------------
+    // Class inner types
+    // ------------------------------
+
+    enum class Stage
+    {
+        HashMove,
+        GenerateCaptures,
+        GoodCaptures,
+        GenerateQuiets,
+        Quiets,
+        BadCaptures,
+        GenerateQuietChecks,
+        QuietChecks,
+        Evasions,
+        Done
+    };
+
+    public:
+    enum class Mode
+    {
+        AllMoves,
+        Captures,
+        CapturesAndQuietChecks,
+    };
+
+    // ------------------------------
+    // Class creation
+    // ------------------------------
+
+    MovePicker() = delete;
+
+    MovePicker(
+        const Board &bd, MoveGenerator::stck &s, const PackedMove hashMove, const Mode mode = Mode::AllMoves,
+        const HistoricTable &ht = {}, const KillerTable &kt = {}, const PackedMove counterMove = {}, const int ply = 0,
+        const int mostRecentMovedSquare = 0, const PositionInfo *info = nullptr
+    )
+        : _stack(s), _gen(bd, s, ht, kt, counterMove, ply, mostRecentMovedSquare, info), _mode(mode),
+          _isCheck(_gen.IsCheck())
+    {
+        if (_isCheck)
+        {
+            _evasions = _gen.GetMovesFast();
+
+            if (!hashMove.IsEmpty())
+                _pullToFront(_evasions, hashMove);
+
+            _stage = Stage::Evasions;
+            return;
+        }
+
+        if (!hashMove.IsEmpty() && (mode == Mode::AllMoves || hashMove.IsCapture() || hashMove.IsPromo()))
+            _hashMove = _validateMove(hashMove);
+
+        _stage = _hashMove.IsEmpty() ? Stage::GenerateCaptures : Stage::HashMove;
+    }
+
+    ~MovePicker()
+    {
+        // popping in reverse order of generation
+        _stack.PopAggregate(_evasions);
+        _stack.PopAggregate(_quiets);
+        _stack.PopAggregate(_captures);
+    }
+
+    MovePicker(const MovePicker &)            = delete;
+    MovePicker(MovePicker &&)                 = delete;
+    MovePicker &operator=(const MovePicker &) = delete;
+    MovePicker &operator=(MovePicker &&)      = delete;
+
+    // ------------------------------
+    // Class interaction
+    // ------------------------------
+
+    /* Returns next move to search or empty move when all moves were returned */
+    Move GetNext()
+    {
+        _lastSEEBound = NEGATIVE_INFINITY;
+
+        switch (_stage)
+        {
+        case Stage::HashMove:
+            _stage = Stage::GenerateCaptures;
+            return _hashMove;
+        case Stage::GenerateCaptures:
+            _captures   = _gen.GetMovesFast<true>();
+            _badCapsInd = _captures.size;
+            _stage      = Stage::GoodCaptures;
+            [[fallthrough]];
+        case Stage::GoodCaptures:
+            while (_capsInd < _badCapsInd)
+            {
+                _pickBest(_captures, _capsInd, _badCapsInd);
+                Move &mv = _captures[_capsInd];
+
+                if (mv.GetPackedMove() == _hashMove.GetPackedMove())
+                {
+                    std::swap(mv, _captures[--_badCapsInd]);
+                    _captures[_badCapsInd] = Move{};
+                    continue;
+                }
+
+                // bad captures are postponed after quiet moves
+                if (!_gen.SEEGe(mv, SEE_GOOD_MOVE_BOUNDARY))
+                {
+                    std::swap(mv, _captures[--_badCapsInd]);
+                    continue;
+                }
+
+                _lastSEEBound = SEE_GOOD_MOVE_BOUNDARY;
+                return _captures[_capsInd++];
+            }
+
+            if (_mode == Mode::Captures)
+                break;
+
+            if (_mode == Mode::CapturesAndQuietChecks)
+            {
+                _stage = Stage::GenerateQuietChecks;
+                return GetNext();
+            }
+
+            _stage = Stage::GenerateQuiets;
+            [[fallthrough]];
+        case Stage::GenerateQuiets:
+            _quiets = _gen.GetMovesFast<false, true, true>();
+            _stage  = Stage::Quiets;
+            [[fallthrough]];
+        case Stage::Quiets:
+            while (_quietsInd < _quiets.size)
+            {
+                _pickBest(_quiets, _quietsInd, _quiets.size);
+
+                if (const Move mv = _quiets[_quietsInd++]; mv.GetPackedMove() != _hashMove.GetPackedMove())
+                    return mv;
+            }
+
+            // bad captures are stored in reverse order of their heuristic evaluation
+            _capsInd = _captures.size;
+            _stage   = Stage::BadCaptures;
+            [[fallthrough]];
+        case Stage::BadCaptures:
+            while (_capsInd > _badCapsInd)
+                if (const Move mv = _captures[--_capsInd]; !mv.IsEmpty())
+                    return mv;
+            break;
+        case Stage::GenerateQuietChecks:
+            _quiets = _gen.GetQuietChecksFast();
+            _stage  = Stage::QuietChecks;
+            [[fallthrough]];
+        case Stage::QuietChecks:
+            while (_quietsInd < _quiets.size)
+            {
+                _pickBest(_quiets, _quietsInd, _quiets.size);
+
+                if (const Move mv = _quiets[_quietsInd++]; mv.GetPackedMove() != _hashMove.GetPackedMove())
+                    return mv;
+            }
+            break;
+        case Stage::Evasions:
+            if (_evasionsInd < _evasions.size)
+            {
+                // the hash move is already placed at the front
+                if (_evasionsInd != 0 || !_isHashMoveFront)
+                    _pickBest(_evasions, _evasionsInd, _evasions.size);
+
+                return _evasions[_evasionsInd++];
+            }
+            break;
+        case Stage::Done:
+            break;
+        }
+
+        _stage = Stage::Done;
+        return {};
+    }
+
+    [[nodiscard]] bool IsCheck() const { return _isCheck; }
+
+    /* Number of legal moves, known only when the king is checked, as all evasions are generated at once */
+    [[nodiscard]] size_t GetEvasionsCount() const { return _evasions.size; }
+
+    /* Returns whether SEE of the last returned move is at least the threshold, reuses the picking SEE test when
+     * it already decides the answer */
+    [[nodiscard]] bool SEEGe(const Move mv, const int threshold) const
+    {
+        return _lastSEEBound >= threshold || _gen.SEEGe(mv, threshold);
+    }
+
+    /* Computes the check flag of the move on demand, must be called before the move is made on the board */
+    [[nodiscard]] bool IsGivingCheck(const Move mv) { return _gen.IsGivingCheck(mv); }
+
+    /* Underlying generator, allows reusing its mechanics e.g. SEE computation */
+    [[nodiscard]] const MoveGenerator &GetGenerator() const { return _gen; }
+
+    // ------------------------------
+    // Private class methods
+    // ------------------------------
+
+    private:
+    // returns the matching legal move or empty one when the move is illegal in the position e.g. due to hash collision
+    Move _validateMove(const PackedMove mv)
+    {
+        if (!mv.IsOkeyMove())
+            return {};
+
+        auto moves = _gen.GetFigureMovesFast<false>(mv.GetStartField());
+
+        Move result{};
+        for (size_t i = 0; i < moves.size; ++i)
+            if (moves[i].GetPackedMove() == mv)
+            {
+                result = moves[i];
+                break;
+            }
+
+        _stack.PopAggregate(moves);
+        return result;
+    }
+
+    void _pullToFront(MoveGenerator::payload &moves, const PackedMove mv)
+    {
+        for (size_t i = 0; i < moves.size; ++i)
+            if (moves[i].GetPackedMove() == mv)
+            {
+                std::swap(moves[0], moves[i]);
+                _isHashMoveFront = true;
+                return;
+            }
+    }
+
+    // swaps the move with the highest heuristic eval inside [begin, end) to the begin position
+    static INLINE void _pickBest(MoveGenerator::payload &moves, const size_t begin, const size_t end)
+    {
+        size_t bestInd = begin;
+        for (size_t i = begin + 1; i < end; ++i)
+            if (moves[i].GetEval() > moves[bestInd].GetEval())
+                bestInd = i;
+
+        std::swap(moves[begin], moves[bestInd]);
+    }
+
+    // ------------------------------
+    // Class fields
+    // ------------------------------
+
+    MoveGenerator::stck &_stack;
+    MoveGenerator _gen;
+    Mode _mode;
+    bool _isCheck;
+    bool _isHashMoveFront{};
+
+    Stage _stage{};
+    Move _hashMove{};
+    // lower bound of SEE of the last returned move known from picking
+    int _lastSEEBound{NEGATIVE_INFINITY};
+
+    MoveGenerator::payload _captures{nullptr, 0};
+    size_t _capsInd{};
+    size_t _badCapsInd{};
+
+    MoveGenerator::payload _quiets{nullptr, 0};
+    size_t _quietsInd{};
+
+    MoveGenerator::payload _evasions{nullptr, 0};
+    size_t _evasionsInd{};
+};
+
+#endif // MOVEPICKER_H
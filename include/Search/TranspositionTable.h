@@ -5,8 +5,14 @@
 #ifndef TRANSPOSITIONTABLES_H
 #define TRANSPOSITIONTABLES_H
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cinttypes>
 #include <immintrin.h>
+#include <mutex>
+#include <string>
+#include <thread>
 
 #include "../EngineUtils.h"
 #include "../MoveGeneration/Move.h"
@@ -29,36 +35,30 @@ struct TranspositionTable
     // Class inner type
     // ------------------------------
 
-    /*
-     *  IMPORTANT: the size of hash record should be any number that is power of 2,
-     *  to allow fast hashing function to do its job here.
-     */
-
     /*
      * The structure below stores all useful information about the position for the search algorithm.
-     * Note that it takes only 48 bits of the hash value, and uses 16 bits for the age value.
-     * It is done to reduce the size and the last 16 bits are mostly irrelevant because of the modulo operation.
-     * It worth to say that minimal size set to be 16 MB (2^24 bytes / 2^4 bytes (size of the structure) ~= 2^20).
-     * So the modulo value is always truncating at least 20 bits of the hash value.
-     *
-     * We are sure that those 20 bits are same when two distinct items land on the same index
+     * It is an unpacked view of the single entry stored inside the table, returned by value from the probes.
+     * Inside the table the record is compressed to a single 64-bit word accompanied by the full zobrist hash
+     * (refer to _entry_t below).
      * */
 
-    struct alignas(16) HashRecord
+    struct HashRecord
     {
         // ------------------------------
         // Class creation
         // ------------------------------
 
+        HashRecord() = default;
+
         HashRecord(
             const uint64_t hash, const PackedMove mv, const int eval, const int statVal, const int depth,
-            const NodeType nType, const uint16_t age, const int ply
+            const NodeType nType, const int ply
         )
-            : _zobristHashAndAgePacked(_packHashAndAge(hash, age)), _madeMove(mv),
-              _eval(AdjustMateScoreForTTIfNeeded(eval, ply)), _value(static_cast<int16_t>(statVal)),
-              _depth(static_cast<uint8_t>(depth)), _type(nType)
+            : _zobristHash(hash), _madeMove(mv), _eval(AdjustMateScoreForTTIfNeeded(eval, ply)),
+              _value(static_cast<int16_t>(statVal)), _depth(static_cast<uint8_t>(depth)), _type(nType)
         {
             TraceIfFalse(depth >= 0, "HashRecord received negative depth");
+            TraceIfFalse(depth < MaxDepth, "HashRecord received too big depth");
             TraceIfFalse(
                 eval <= POSITIVE_INFINITY && eval >= NEGATIVE_INFINITY, "Received eval outside possible bounds!"
             );
@@ -91,25 +91,12 @@ struct TranspositionTable
 
         [[nodiscard]] int GetStatVal() const { return _value; }
         [[nodiscard]] int GetDepth() const { return _depth; }
-        [[nodiscard]] bool IsEmpty() const { return GetAge() == 0; }
-        [[nodiscard]] uint16_t GetAge() const { return _zobristHashAndAgePacked & AgeBytes; }
         [[nodiscard]] NodeType GetNodeType() const { return _type; }
-        [[nodiscard]] bool IsSameHash(const uint64_t hash) const
-        {
-            // Note: Hash is packed together with age, so we need to compare only valuable part
-            return (hash & HashBytes) == (_zobristHashAndAgePacked & HashBytes);
-        }
+        [[nodiscard]] bool IsSameHash(const uint64_t hash) const { return _isFilled && hash == _zobristHash; }
 
         void SetStatVal(const int statEval) { _value = static_cast<int16_t>(statEval); }
         void SetEvalVal(const int eval) { _eval = static_cast<int16_t>(eval); }
 
-        // ------------------------------
-        // Private class methods
-        // ------------------------------
-
-        private:
-        static uint64_t _packHashAndAge(const uint64_t Hash, const uint16_t age) { return (Hash & HashBytes) | age; }
-
         // ------------------------------
         // Class fields
         // ------------------------------
@@ -120,22 +107,241 @@ struct TranspositionTable
         private:
 #endif
 
-        uint64_t _zobristHashAndAgePacked; // 6 bytes for valuable hash part and 2 bytes for age
-        PackedMove _madeMove;              // 2 Bytes
-        int16_t _eval;                     // 2 bytes
-        int16_t _value;                    // 2 bytes
-        uint8_t _depth;                    // 1 byte
-        NodeType _type;                    // 1 byte
+        uint64_t _zobristHash{};
+        PackedMove _madeMove{};
+        int16_t _eval{};
+        int16_t _value{NO_EVAL_RESERVED_VALUE};
+        uint8_t _depth{};
+        NodeType _type{};
+        bool _isFilled{};
 
-        // Mask used to hash age
-        static constexpr uint64_t AgeBytes = 0xFFFF;
-
-        // Mask used to hash zobrist hash of the position
-        static constexpr uint64_t HashBytes = ~AgeBytes;
+        // depth is stored on 8 bits with the offset allowing to distinguish empty entries
+        static constexpr int MaxDepth = 0xFF;
 
         friend TranspositionTable;
     };
 
+    private:
+    struct _sharedEntry_t;
+
+    /*
+     * Snapshot of a single entry stored inside the bucket. Whole record except the hash is packed into single
+     * 64-bit word:
+     *
+     * bits  0-15: move
+     * bits 16-31: eval
+     * bits 32-47: static eval
+     * bits 48-55: depth + 1, 0 marks empty entry
+     * bits 56-57: node type
+     * bits 58-63: generation of the search, which saved the entry
+     * */
+
+    struct _entry_t
+    {
+        [[nodiscard]] INLINE bool IsEmpty() const { return _getDepthBits() == 0; }
+
+        [[nodiscard]] INLINE uint64_t GetHash() const { return _hash; }
+
+        [[nodiscard]] INLINE int GetDepth() const { return static_cast<int>(_getDepthBits()) - 1; }
+
+        [[nodiscard]] INLINE PackedMove GetMove() const
+        {
+            return std::bit_cast<PackedMove>(static_cast<uint16_t>(_data & Bit16Mask));
+        }
+
+        [[nodiscard]] INLINE uint8_t GetGeneration() const
+        {
+            return static_cast<uint8_t>(_data >> GenerationShift) & GenerationMask;
+        }
+
+        [[nodiscard]] static INLINE _entry_t Pack(const HashRecord &record, const uint8_t generation)
+        {
+            _entry_t entry;
+
+            entry._hash = record._zobristHash;
+            entry._data = static_cast<uint64_t>(std::bit_cast<uint16_t>(record._madeMove)) |
+                          static_cast<uint64_t>(static_cast<uint16_t>(record._eval)) << EvalShift |
+                          static_cast<uint64_t>(static_cast<uint16_t>(record._value)) << StatValShift |
+                          static_cast<uint64_t>(record._depth + 1) << DepthShift |
+                          static_cast<uint64_t>(record._type) << TypeShift |
+                          static_cast<uint64_t>(generation & GenerationMask) << GenerationShift;
+
+            return entry;
+        }
+
+        [[nodiscard]] INLINE HashRecord Unpack() const
+        {
+            HashRecord record{};
+
+            record._zobristHash = _hash;
+            record._madeMove    = GetMove();
+            record._eval        = static_cast<int16_t>(_data >> EvalShift & Bit16Mask);
+            record._value       = static_cast<int16_t>(_data >> StatValShift & Bit16Mask);
+            record._depth       = static_cast<uint8_t>(GetDepth());
+            record._type        = static_cast<NodeType>(_data >> TypeShift & TypeMask);
+            record._isFilled    = true;
+
+            return record;
+        }
+
+        INLINE void SetStatVal(const int statVal)
+        {
+            _data = (_data & ~(Bit16Mask << StatValShift)) |
+                    static_cast<uint64_t>(static_cast<uint16_t>(statVal)) << StatValShift;
+        }
+
+        static constexpr uint64_t Bit16Mask       = 0xFFFF;
+        static constexpr uint64_t TypeMask        = 0b11;
+        static constexpr uint8_t GenerationMask   = 0b111111;
+        static constexpr uint64_t EvalShift       = 16;
+        static constexpr uint64_t StatValShift    = 32;
+        static constexpr uint64_t DepthShift      = 48;
+        static constexpr uint64_t TypeShift       = 56;
+        static constexpr uint64_t GenerationShift = 58;
+
+        private:
+        [[nodiscard]] INLINE uint64_t _getDepthBits() const { return (_data >> DepthShift) & 0xFF; }
+
+        uint64_t _hash;
+        uint64_t _data;
+
+        friend struct _sharedEntry_t;
+    };
+
+    /*
+     * Entry as it is stored inside the table, shared between all search threads without any locks.
+     * Hash is saved xor-ed with the data word, so when other thread overwrites the entry in the middle of
+     * our read (or two threads write to it at once) the decoded hash does not match the probed one and the torn
+     * entry is simply treated as a miss. Both words are atomics accessed with relaxed ordering, which compiles to
+     * plain moves, but guarantees that every single word is read and written as a whole.
+     *
+     * References:
+     * - https://www.chessprogramming.org/Shared_Hash_Table#Lockless
+     * */
+
+    struct _sharedEntry_t
+    {
+        [[nodiscard]] INLINE _entry_t Load() const
+        {
+            _entry_t entry;
+
+            entry._data = _data.load(std::memory_order_relaxed);
+            entry._hash = _hashXorData.load(std::memory_order_relaxed) ^ entry._data;
+
+            return entry;
+        }
+
+        INLINE void Store(const _entry_t &entry)
+        {
+            _hashXorData.store(entry._hash ^ entry._data, std::memory_order_relaxed);
+            _data.store(entry._data, std::memory_order_relaxed);
+        }
+
+        private:
+        std::atomic<uint64_t> _hashXorData;
+        std::atomic<uint64_t> _data;
+    };
+
+    static constexpr size_t _bucketSize      = 64;
+    static constexpr size_t EntriesPerBucket = _bucketSize / sizeof(_sharedEntry_t);
+
+    /*
+     *  IMPORTANT: the size of bucket should be any number that is power of 2,
+     *  to allow fast hashing function to do its job here.
+     *
+     *  Bucket fills exactly one cache line, so single prefetch is enough to serve the whole probe.
+     */
+
+    struct alignas(_bucketSize) _bucket_t
+    {
+        _sharedEntry_t entries[EntriesPerBucket];
+    };
+
+    static_assert(sizeof(_bucket_t) == _bucketSize);
+    static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+    /* Header preceding the table inside the file, format version must be bumped on every change of the entry layout */
+    struct _fileHeader_t
+    {
+        uint64_t magic;
+        uint32_t formatVersion;
+        uint32_t bucketSize;
+        uint32_t entriesPerBucket;
+        uint32_t generation;
+        uint64_t bucketCount;
+        uint64_t hashSeed;
+    };
+
+    static constexpr uint64_t _fileMagic         = 0x5454524843454843; // "CHECHRTT"
+    static constexpr uint32_t _fileFormatVersion = 2;
+
+    // header is padded to the page size, so the mapped table stays page aligned
+    static constexpr size_t _fileHeaderSize = 4096;
+    static_assert(sizeof(_fileHeader_t) <= _fileHeaderSize);
+
+    public:
+    /*
+     * Statistics about the table usage gathered by single search thread. Every thread owns its instance,
+     * so there is no contention on the counters, and merges it into the table ones at the end of each iteration.
+     * All counters are broken down by the depth of the probing node and by the type of the saved node.
+     * */
+
+    struct Statistics
+    {
+        static constexpr size_t NodeTypeCount = 3;
+        static constexpr size_t DepthCount    = MAX_SEARCH_DEPTH + 1;
+
+        struct DepthStats
+        {
+            uint64_t probes;
+            uint64_t hits[NodeTypeCount];
+            uint64_t cutoffs[NodeTypeCount];
+            uint64_t stores[NodeTypeCount];
+            uint64_t overwrites[NodeTypeCount];
+        };
+
+        INLINE void RecordProbe(const int depth, const bool wasHit, const NodeType type)
+        {
+            DepthStats &stats = _getDepth(depth);
+
+            ++stats.probes;
+            stats.hits[type] += wasHit;
+        }
+
+        INLINE void RecordCutoff(const int depth, const NodeType type) { ++_getDepth(depth).cutoffs[type]; }
+
+        INLINE void RecordStore(const int depth, const NodeType type, const bool wasOverwrite)
+        {
+            DepthStats &stats = _getDepth(depth);
+
+            ++stats.stores[type];
+            stats.overwrites[type] += wasOverwrite;
+        }
+
+        void Merge(const Statistics &other);
+
+        void Clear();
+
+        DepthStats PerDepth[DepthCount]{};
+
+        // probes of the per-thread evaluation tables, displayed together with the table ones
+        struct EvalTableStats
+        {
+            uint64_t probes;
+            uint64_t hits;
+        };
+
+        EvalTableStats PawnTable{};
+        EvalTableStats MaterialTable{};
+        EvalTableStats EvalCache{};
+
+        private:
+        [[nodiscard]] INLINE DepthStats &_getDepth(const int depth)
+        {
+            return PerDepth[std::clamp(depth, 0, static_cast<int>(DepthCount) - 1)];
+        }
+    };
+
     // ------------------------------
     // Class creation
     // ------------------------------
@@ -156,8 +362,14 @@ struct TranspositionTable
     // Class interaction
     // ------------------------------
 
-    // Method adds new record to the table
-    INLINE void Add(const HashRecord &record, const uint64_t zHash)
+    /*
+     * Method adds new record to the table. Record replaces the entry of the same position if it exists inside
+     * the bucket, otherwise the empty one or the least valuable one is replaced. The value of the entry
+     * is its depth decreased by the number of searches that were conducted since the entry was saved.
+     *
+     * Returns true when the entry of other position was overwritten.
+     * */
+    INLINE bool Add(const HashRecord &record, const uint64_t zHash)
     {
         TraceIfFalse(
             (record.GetNodeType() == UPPER_BOUND && record.GetMove().IsEmpty()) ||
@@ -165,23 +377,63 @@ struct TranspositionTable
             "Saved move is not valid!"
         );
 
-        // hash uses 48 bytes inside the record while masks uses at least log2(16 * 1024 * 1024 / 16) = 20
-        const size_t pos = zHash & _hashMask;
+        _bucket_t &bucket = _map[zHash & _hashMask];
+        _sharedEntry_t *replace = bucket.entries;
+        _entry_t replaced       = replace->Load();
+
+        for (_sharedEntry_t &sharedEntry : bucket.entries)
+        {
+            const _entry_t entry = sharedEntry.Load();
+
+            if (entry.IsEmpty() || entry.GetHash() == zHash)
+            {
+                replace  = &sharedEntry;
+                replaced = entry;
+                break;
+            }
 
-        // if previously field was empty we need to increment the counter of contained records
-        _containedRecords += _map[pos].IsEmpty();
+            if (_getReplaceValue(entry) < _getReplaceValue(replaced))
+            {
+                replace  = &sharedEntry;
+                replaced = entry;
+            }
+        }
 
         // save the given record
-        _map[pos] = record;
+        replace->Store(_entry_t::Pack(record, _generation));
+
+        return !replaced.IsEmpty() && replaced.GetHash() != zHash;
     }
 
-    // Methods retrieves record from the table
-    [[nodiscard]] INLINE HashRecord &GetRecord(const uint64_t zHash) const
+    // Methods retrieves copy of the record from the table, when no record was found returns empty one
+    [[nodiscard]] INLINE HashRecord GetRecord(const uint64_t zHash) const
     {
-        const size_t pos = zHash & _hashMask;
-        return _map[pos];
+        const _bucket_t &bucket = _map[zHash & _hashMask];
+
+        for (const _sharedEntry_t &sharedEntry : bucket.entries)
+            if (const _entry_t entry = sharedEntry.Load(); !entry.IsEmpty() && entry.GetHash() == zHash)
+                return entry.Unpack();
+
+        return {};
     }
 
+    // Saves the static evaluation inside the record of given position, if such record exists
+    INLINE void SetStatVal(const uint64_t zHash, const int statVal)
+    {
+        _bucket_t &bucket = _map[zHash & _hashMask];
+
+        for (_sharedEntry_t &sharedEntry : bucket.entries)
+            if (_entry_t entry = sharedEntry.Load(); !entry.IsEmpty() && entry.GetHash() == zHash)
+            {
+                entry.SetStatVal(statVal);
+                sharedEntry.Store(entry);
+                return;
+            }
+    }
+
+    // Should be called before every new search to age the entries saved by previous searches
+    INLINE void IncrementGeneration() { _generation = (_generation + 1) & _entry_t::GenerationMask; }
+
     // Method used to prefetch the record from the table short time before accessing it.
     // If we cannot find appropriate record this function becomes a noop.
     INLINE void Prefetch(const uint64_t zHash)
@@ -196,20 +448,51 @@ struct TranspositionTable
 #endif
     }
 
+    /* Clears the table using multiple threads, blocks until the work is finished */
     void ClearTable();
 
-    INLINE void UpdateStatistics(bool wasTTHit)
-    {
-        _hitsCount += wasTTHit;
-        _missCount += !wasTTHit;
-    }
+    /* Starts clearing the table in the background, WaitForReady must be called before any further table usage */
+    void ClearTableAsync();
+
+    /* Blocks until background resize or clear is finished, no-op when there is no work in progress */
+    void WaitForReady();
+
+    [[nodiscard]] bool IsReady() const { return !_backgroundThread.joinable(); }
+
+    /* Adds the statistics gathered by single thread to the table ones and clears them */
+    void MergeStatistics(Statistics &stats);
 
     void DisplayStatisticsAndReset();
 
+    /* Statistics are gathered when enabled at runtime or when TEST_TT compilation flag is defined */
+    [[nodiscard]] bool IsStatisticsEnabled() const { return TestTT || _statisticsEnabled; }
+
+    void SetStatisticsEnabled(const bool enabled) { _statisticsEnabled = enabled; }
+
     // IMPORTANT: function should only be used before any search was concluded, because is fully cleared when resizing
     signed_size_t ResizeTable(size_t sizeMB);
 
-    [[nodiscard]] size_t GetContainedElements() const;
+    // Same as above, but the old table is released and the new one is allocated, cleared and prefaulted in the
+    // background, refer to ClearTableAsync. Returns the size the table is being resized to, allocation failure is
+    // reported by the background task, after which the table falls back to the default size.
+    signed_size_t ResizeTableAsync(size_t sizeMB);
+
+    /*
+     * Dumps whole table to the file preceded by the header describing the table size, zobrist seed and entry format.
+     * File is written to temporary location first and then renamed, so the file that is currently mapped by the table
+     * can be safely overwritten.
+     * */
+    bool SaveToFile(const std::string &path);
+
+    /*
+     * Replaces the table with the one saved by SaveToFile. Files with different entry format or hash seed are rejected.
+     * On linux the file is mapped read-write in private mode, so the search changes stay in memory until the next save.
+     * Table size is taken from the file.
+     * */
+    bool LoadFromFile(const std::string &path);
+
+    /* Returns the permille of the table filled by the current search, based on the first entries of the table */
+    [[nodiscard]] size_t GetHashFull() const;
 
     /* Function adjusts the mate score to prevent returning mate scores from TT with misleading values */
     [[nodiscard]] static INLINE int AdjustMateScoreForTT(const int eval, const int ply)
@@ -235,6 +518,23 @@ struct TranspositionTable
     private:
     void _checkForCorrectAlloc(size_t size) const;
 
+    // allocates the table using huge pages when possible, sets the size and the mask accordingly
+    void _allocate(size_t bucketCount);
+
+    // frees the previous table and allocates new one, returns the size of the table in MB or -1 on failure
+    signed_size_t _reallocate(size_t sizeMB);
+
+    // splits the table between multiple threads and zeroes it, touching every page at the same time
+    void _parallelClear();
+
+    [[nodiscard]] static bool _isFileHeaderValid(const _fileHeader_t &header, size_t fileSize);
+
+    [[nodiscard]] INLINE int _getReplaceValue(const _entry_t &entry) const
+    {
+        const int relativeAge = (_generation - entry.GetGeneration()) & _entry_t::GenerationMask;
+        return entry.GetDepth() - TT_AGE_REPLACE_WEIGHT * relativeAge;
+    }
+
     static size_t _getPow2ModuloMask(const size_t pow2Num) { return pow2Num - 1; }
 
     // ------------------------------
@@ -245,19 +545,27 @@ struct TranspositionTable
     static constexpr size_t MaxSizeMB        = 1024 * 256;
     static constexpr size_t StartTableSizeMB = 16;
     static constexpr size_t MB               = 1024 * 1024;
-    static constexpr size_t StartTableSize   = StartTableSizeMB * MB / sizeof(HashRecord);
+    static constexpr size_t StartTableSize   = StartTableSizeMB * MB / sizeof(_bucket_t);
 
     private:
-    static constexpr size_t _entryAlignment = 16;
+    // minimal part of the table cleared by a single thread, prevents spawning threads for small tables
+    static constexpr size_t _minClearChunkSize = 64 * MB;
+
+    // count of entries sampled to calculate hashfull
+    static constexpr size_t _hashFullSampleSize = 1000;
+
+    std::thread _backgroundThread{};
 
-    size_t _containedRecords{};
     size_t _tableSize{};
     size_t _hashMask{};
-    HashRecord *_map{};
+    uint8_t _generation{};
+    LargePageAllocation _allocation{};
+    _bucket_t *_map{};
 
     // used to gather statistics about the run
-    uint64_t _hitsCount{};
-    uint64_t _missCount{};
+    bool _statisticsEnabled{};
+    std::mutex _statisticsMutex{};
+    Statistics _statistics{};
 };
 
 extern TranspositionTable TTable;
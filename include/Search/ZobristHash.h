@@ -7,8 +7,8 @@
 
 #include <cinttypes>
 
+#include "../Board.h"
 #include "../EngineUtils.h"
-#include "../MoveGeneration/Move.h"
 
 /*  Class responsible for hashing the whole board into
  *  unique number, which special property that similar
@@ -29,30 +29,45 @@ struct ZobristHasher
 
     [[nodiscard]] uint64_t GenerateHash(const Board &board) const;
 
-    [[nodiscard]] INLINE uint64_t UpdateHash(uint64_t oldHash, const Move mv, const VolatileBoardData &data) const
-    {
-        oldHash ^= _colorHash;                                                 // swapping color
-        oldHash ^= _mainHashes[mv.GetStartBoardIndex()][mv.GetStartField()];   // placing a figure on target square
-        oldHash ^= _mainHashes[mv.GetTargetBoardIndex()][mv.GetTargetField()]; // removing a figure from start square
-        oldHash ^=
-            _mainHashes[mv.GetKilledBoardIndex()][mv.GetKilledFigureField()]; // removing a killed figure from the board
+    /* Generates hash of the pawn structure only, pawns of both colors are hashed with the main piece hashes */
+    [[nodiscard]] uint64_t GeneratePawnHash(const Board &board) const;
 
-        oldHash ^= _elPassantHashes[ExtractMsbPos(data.OldElPassant)]; // removing old ElPassantField
-        oldHash ^= _elPassantHashes[mv.GetElPassantField()];           // placing new elPassantFiled
+    /* Generates hash of the material signature - the number of figures of every type on the board */
+    [[nodiscard]] uint64_t GenerateMaterialHash(const Board &board) const;
 
-        const unsigned long long rights1 = data.Castlings.to_ullong();
-        oldHash ^= _castlingHashes[rights1]; // removing old castlings
+    /* Sets all hashes stored inside the board, must be used after any direct modification of the board */
+    void RecomputeHashes(Board &board) const;
 
-        const unsigned long long rights2 = mv.GetCastlingRights().to_ullong();
-        oldHash ^= _castlingHashes[rights2]; // placing new ones
+    // ------------------------------
+    // Hash parts used in incremental updates
+    // ------------------------------
 
-        // applying additional castling operation
-        const auto [boardIndex, field] = Move::CastlingActions[mv.GetCastlingType()];
-        oldHash ^= _mainHashes[boardIndex][ExtractMsbPos(field)];
+    [[nodiscard]] INLINE uint64_t GetPieceHash(const size_t boardIndex, const int msbPos) const
+    {
+        return _mainHashes[boardIndex][msbPos];
+    }
 
-        return oldHash;
+    // zero for every non pawn board, so the pawn hash may be updated unconditionally
+    [[nodiscard]] INLINE uint64_t GetPawnHash(const size_t boardIndex, const int msbPos) const
+    {
+        return _pawnHashes[boardIndex][msbPos];
     }
 
+    // hash of the 'figureNum'-th figure of given type
+    [[nodiscard]] INLINE uint64_t GetMaterialHash(const size_t boardIndex, const int figureNum) const
+    {
+        return _materialHashes[boardIndex][figureNum];
+    }
+
+    [[nodiscard]] INLINE uint64_t GetColorHash() const { return _colorHash; }
+
+    [[nodiscard]] INLINE uint64_t GetCastlingHash(const std::bitset<Board::CastlingCount + 1> castlings) const
+    {
+        return _castlingHashes[castlings.to_ullong()];
+    }
+
+    [[nodiscard]] INLINE uint64_t GetElPassantHash(const int msbPos) const { return _elPassantHashes[msbPos]; }
+
     [[nodiscard]] bool ValidateQuality(int diffBits, bool log = false) const;
     [[nodiscard]] static uint64_t SearchForSeed(uint64_t startSeed, int bitDiffs, bool log = false);
 
@@ -78,7 +93,11 @@ struct ZobristHasher
     private:
     static constexpr size_t CastlingHashesCount = 32; // 2^(4 + 1) each castling property can be either 1 or 0
                                                       // and additional sentinel
+    static constexpr size_t MaxFiguresOfType    = 16; // 10 knights at most: 2 + 8 promoted pawns
+
     uint64_t _mainHashes[Board::BitBoardsCount + 1][Board::BitBoardFields]{};
+    uint64_t _pawnHashes[Board::BitBoardsCount + 1][Board::BitBoardFields]{};
+    uint64_t _materialHashes[Board::BitBoardsCount + 1][MaxFiguresOfType]{};
     uint64_t _colorHash{};
     uint64_t _castlingHashes[CastlingHashesCount]{};
     uint64_t _elPassantHashes[Board::BitBoardFields]{};
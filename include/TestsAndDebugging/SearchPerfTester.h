@@ -10,6 +10,7 @@
 
 #include "../EngineUtils.h"
 #include "../MoveGeneration/Move.h"
+#include "../Search/BestMoveSearch.h"
 #include "../ThreadManagement/Stack.h"
 
 struct SearchPerfTester
@@ -26,7 +27,8 @@ struct SearchPerfTester
     // ------------------------------
 
     static bool PerformSearchPerfTest(
-        const std::string &inputTestPath, const std::string &output, Stack<Move, DEFAULT_STACK_SIZE> &stack
+        const std::string &inputTestPath, const std::string &output, Stack<Move, DEFAULT_STACK_SIZE> &stack,
+        BestMoveSearch::EvalTables &evalTables
     );
 
     // ------------------------------
@@ -34,8 +36,10 @@ struct SearchPerfTester
     // ------------------------------
 
     private:
-    [[nodiscard]] static double
-    _performTestCase(const std::string &testCase, int depth, Stack<Move, DEFAULT_STACK_SIZE> &stack);
+    [[nodiscard]] static double _performTestCase(
+        const std::string &testCase, int depth, Stack<Move, DEFAULT_STACK_SIZE> &stack,
+        BestMoveSearch::EvalTables &evalTables
+    );
     static void
     _saveResultsToCsv(const std::string &output, const std::vector<std::tuple<std::string, int, double>> &results);
 
@@ -5,8 +5,12 @@
 #ifndef CHECKMATE_CHARIOT_GAMETIMER_H
 #define CHECKMATE_CHARIOT_GAMETIMER_H
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
 
 #include "../Board.h"
 #include "../EngineUtils.h"
@@ -33,18 +37,20 @@ class [[maybe_unused]] GameTimeManager
     // ------------------------------
 
     /// <summary>
-    /// Start the timer asynchronously, on separate thread. This function will periodically check the current time and
-    /// update the CurrentTime field.
+    /// Start the timer thread. The thread lives for the whole program and is reused by every search. It sleeps until
+    /// the deadline of the current search is reached or until the deadline is changed or cancelled.
     /// </summary>
     [[maybe_unused]] static void StartTimerAsync();
 
-    /// @brief Force update the CurrentTime field
-    [[maybe_unused]] static std::chrono::time_point<std::chrono::system_clock> ForceUpdateCurrentTime();
+    /// <summary>
+    /// Wake up the timer thread, let it exit and join it. Called automatically when the program exits, so the thread
+    /// never waits on the synchronisation objects while they are destroyed.
+    /// </summary>
+    static void StopTimer();
 
     /// <summary>
-    /// Start the search management asynchronously, on separate thread. This function will periodically check if the
-    /// engine still has time to search for the best move. If the time is up, the variable ShouldStop will be set to
-    /// true.
+    /// Start the search management. Computes the time for the move and publishes the deadline for the searchers and the
+    /// timer thread, no thread is created. When the time is up, the variable ShouldStop will be set to true.
     /// </summary>
     static void
     StartSearchManagementAsync(const GoTimeInfo &tInfo, const Color color, const Board &bd, const uint16_t moveAge);
@@ -56,12 +62,25 @@ class [[maybe_unused]] GameTimeManager
     /* Function starts time management accordingly to previously saved times */
     static void PonderHit(Color color, const Board &bd);
 
-    /// <summary> Stop the search management thread </summary>
+    /// <summary> Stop the search and cancel the deadline of the timer thread </summary>
     static void StopSearchManagement();
 
-    static auto GetCurrentTime() { return CurrentTime; }
+    static auto GetCurrentTime() { return std::chrono::steady_clock::now(); }
+
+    static bool GetShouldStop() { return ShouldStop.load(std::memory_order_relaxed); }
+
+    /// <summary>
+    /// Checks the deadline of the current search against the steady clock and raises the stop flag once it passed.
+    /// Called by every searcher after each TIME_CHECK_NODE_INTERVAL nodes.
+    /// </summary>
+    static void CheckDeadline()
+    {
+        if (_getSteadyNs() >= _searchDeadlineNs.load(std::memory_order_relaxed))
+            ShouldStop.store(true, std::memory_order_relaxed);
+    }
 
-    static bool GetShouldStop() { return ShouldStop; }
+    /* Returns how many microseconds passed since the deadline of the last timed search, negative if not reached */
+    static lli GetDeadlineOvershootUs();
 
     /// <summary> Calculate the time in milliseconds for a move </summary>
     [[maybe_unused]] static lli CalculateTimeMsPerMove(
@@ -71,11 +90,21 @@ class [[maybe_unused]] GameTimeManager
 
     private:
     /// @See StartTimerAsync
-    [[noreturn]] static void _timer_thread();
+    static void _timer_thread();
 
-    /// @See StartSearchManagementAsync
-    static void
-    _search_management_thread(std::chrono::time_point<std::chrono::system_clock> moveStartTimeMs, lli timeForMoveMs);
+    /// @brief Passes the new deadline to the timer thread and wakes it up
+    static void _setDeadline(std::chrono::time_point<std::chrono::steady_clock> deadline);
+
+    /// @brief Removes the deadline so the timer thread goes back to sleep
+    static void _cancelDeadline();
+
+    static lli _getSteadyNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()
+        )
+            .count();
+    }
 
     // ------------------------------
     // Class fields
@@ -85,17 +114,12 @@ class [[maybe_unused]] GameTimeManager
     /// @brief Time when the timer was started
     static std::chrono::time_point<std::chrono::system_clock> TimeStart;
 
-    /// @brief Current time
-    static std::chrono::time_point<std::chrono::system_clock> CurrentTime;
-
-    /// @brief Flag indicating if the search should stop
-    static bool ShouldStop;
+    /// @brief Flag indicating if the search should stop, read by the searchers on every node
+    static std::atomic<bool> ShouldStop;
 
     static int32_t GeneralExpectedMoves;
 
     private:
-    /// @brief Resolution of the timer in milliseconds
-    static constexpr uint32_t resolutionMs = 1;
     static double expectedMoves;
     static double moveCorrection;
 
@@ -108,9 +132,17 @@ class [[maybe_unused]] GameTimeManager
     static constexpr double adaptationFactor      = 1.0 / 40;
     static constexpr double distribution          = 0.0;
 
-    // Wake on update mechanism
+    // Deadline of the current search, guarded by the mutex, timer thread is woken up on every change
     static std::condition_variable cv;
     static std::mutex mtx;
+    static std::chrono::time_point<std::chrono::steady_clock> _deadline;
+    static bool _isDeadlineActive;
+    static bool _shouldTimerExit;
+    static std::thread _timerThread;
+
+    // Deadline of the current search in steady clock nanoseconds, checked directly by the searchers
+    static constexpr lli NoDeadline = std::numeric_limits<lli>::max();
+    static std::atomic<lli> _searchDeadlineNs;
 
     static GoTimeInfo _ponderTimes;
 };
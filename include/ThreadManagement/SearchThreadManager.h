@@ -5,15 +5,31 @@
 #ifndef SEARCHTHREADMANAGER_H
 #define SEARCHTHREADMANAGER_H
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <semaphore>
 #include <string>
 #include <thread>
 
 #include "../EngineUtils.h"
 #include "../MoveGeneration/Move.h"
+#include "../Search/BestMoveSearch.h"
 #include "Stack.h"
 
+/*
+ * Class manages all threads taking part in the search.
+ *
+ * Search is parallelized using Lazy SMP scheme: every enabled thread runs its own iterative deepening on the copy of
+ * the root position, with its own Stack, KillerTable, HistoricTable and CounterMoveTable. The only shared component is
+ * the global Transposition Table, through which threads exchange the results. Helper threads skip some iterations
+ * (refer to BestMoveSearch) to diversify the searched trees. Main thread is the only one reporting infos, after it
+ * finishes all helpers are stopped and the best result among all threads is selected.
+ *
+ * References:
+ * - https://www.chessprogramming.org/Lazy_SMP
+ * */
+
 class SearchThreadManager
 {
     // ------------------------------
@@ -26,6 +42,23 @@ class SearchThreadManager
         int depth;
     };
 
+    /* Result of single search thread, used to select the best move after the search */
+    struct _threadResult_t
+    {
+        PackedMove bestMove;
+        PackedMove ponderMove;
+        int eval;
+        int depth;
+    };
+
+    /* All components needed to control single passive search thread */
+    struct _worker_t
+    {
+        std::thread *thread{};
+        std::binary_semaphore taskSem{0};
+        bool shouldStop{false};
+    };
+
     public:
     using StackType = Stack<Move, DEFAULT_STACK_SIZE>;
 
@@ -47,7 +80,17 @@ class SearchThreadManager
     // Class interaction
     // ------------------------------
 
-    [[nodiscard]] StackType &GetDefaultStack() { return _stacks[0]; }
+    [[nodiscard]] StackType &GetDefaultStack() { return *_stacks[MainSearchThreadInd]; }
+
+    /* Returns eval tables of the main search thread, may be used by other tasks only when no search is running */
+    [[nodiscard]] BestMoveSearch::EvalTables &GetDefaultEvalTables() { return *_evalTables[MainSearchThreadInd]; }
+
+    /* Returns stack of given search thread, may be used by other tasks only when no search is running */
+    [[nodiscard]] StackType &GetThreadStack(const size_t threadInd)
+    {
+        TraceIfFalse(threadInd < _threadCount, "Stack of disabled thread requested!");
+        return *_stacks[threadInd];
+    }
 
     bool Go(const Board &bd, const GoInfo &info);
 
@@ -58,6 +101,15 @@ class SearchThreadManager
 
     void Stop() const;
 
+    /* Changes count of threads used by the search, returns false when the search is running */
+    bool SetThreadCount(size_t threadCount);
+
+    [[nodiscard]] size_t GetThreadCount() const { return _threadCount; }
+
+    /* Changes size of the static evaluation cache of every thread, 0 disables the caches, returns false when the search
+     * is running */
+    bool SetEvalCacheSize(size_t sizeMB);
+
     [[nodiscard]] bool IsSearchOn() const { return _isSearchOn; }
 
     [[nodiscard]] bool IsPonderOn() const { return _isPonderOn; }
@@ -69,34 +121,56 @@ class SearchThreadManager
     // ------------------------------
 
     private:
-    static void _passiveThreadSearchJob(
-        Stack<Move, DEFAULT_STACK_SIZE> *s, _searchArgs_t *args, bool *guard, const bool *shouldStop,
-        std::binary_semaphore *taskSem, std::binary_semaphore *bootup
-    );
+    static void _passiveThreadSearchJob(SearchThreadManager *manager, size_t threadInd);
+
+    /* Runs the search on the main thread, controls the helpers and displays the final result */
+    void _mainThreadSearch(const _searchArgs_t &args);
+
+    /* Runs the search on the helper thread and saves the result to the corresponding slot */
+    void _helperThreadSearch(size_t threadInd);
+
+    /* Selects the thread with the best result, main thread result is preferred unless some helper finished deeper
+     * iteration with better score */
+    [[nodiscard]] const _threadResult_t &_selectBestResult(size_t threadCount) const;
+
+    /* Displays how long after the deadline of the timed search the best move is returned */
+    static void _reportOvershoot();
+
+    void _startThread(size_t threadInd);
+
+    void _stopThread(size_t threadInd);
 
     // ------------------------------
     // Class fields
     // ------------------------------
 
-    bool _isSearchOn{false};
-    bool _isPonderOn{false};
-
-    // Passive thread components
-    bool _shouldStop{false};
-    std::binary_semaphore _searchSem{0};
-    std::binary_semaphore _bootupSem{0};
-    _searchArgs_t _searchArgs{};
-
+    public:
     // TODO: Implement logical thread detection
-
-    static constexpr size_t MaxSearchThreads   = 20;
+    static constexpr size_t MaxSearchThreads   = 64;
     static constexpr size_t MaxManagingThreads = 1;
     static constexpr size_t MaxThreadCount     = MaxSearchThreads + MaxManagingThreads;
 
-    StackType _stacks[MaxThreadCount]{};
-    std::thread *_threads[MaxThreadCount]{};
-
+    private:
     static constexpr size_t MainSearchThreadInd = 0;
+
+    // read by the UCI thread, written by the main search thread
+    std::atomic<bool> _isSearchOn{false};
+    bool _isPonderOn{false};
+
+    // Passive thread components
+    std::binary_semaphore _bootupSem{0};
+    std::counting_semaphore<MaxSearchThreads> _helpersFinishedSem{0};
+    _searchArgs_t _searchArgs{};
+    _searchArgs_t _helperArgs{};
+    size_t _threadCount{1};
+
+    // Stacks and eval tables exist only for enabled threads, they are created and destroyed together with them
+    std::unique_ptr<StackType> _stacks[MaxSearchThreads]{};
+    std::unique_ptr<BestMoveSearch::EvalTables> _evalTables[MaxSearchThreads]{};
+    size_t _evalCacheSizeMB{EVAL_CACHE_DEFAULT_SIZE_MB};
+    _worker_t _workers[MaxSearchThreads]{};
+    _threadResult_t _results[MaxSearchThreads]{};
+    BestMoveSearch::ThreadNodeCounter _nodeCounters[MaxSearchThreads]{};
 };
 
 #endif // SEARCHTHREADMANAGER_H
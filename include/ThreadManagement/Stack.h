@@ -6,6 +6,7 @@
 #define STACK_H
 
 #include <cstdlib>
+#include <new>
 
 #include "../EngineUtils.h"
 
@@ -17,6 +18,7 @@
  *
  *  Its main use case is to provide reliable and fast Stack implementation, allocate once used consistently during
  *  a thread lifetime. Also allows simple thread cancelling mechanism to work without any worries about memory leaks.
+ *  Capacity should cover the worst case, as untouched memory costs only the address space.
  *  It is not thread safe, and it should not be.
  */
 
@@ -51,8 +53,14 @@ template <class ItemT, size_t StackSize> struct Stack
     // Class creation
     // ------------------------------
 
-    Stack() : _data(static_cast<ItemT *>(AlignedAlloc(sizeof(ItemT), sizeof(ItemT) * StackSize))) {}
-    ~Stack() { AlignedFree(_data); }
+    /* Only the address space is reserved, pages are committed when the stack grows into them */
+    Stack() : _data(static_cast<ItemT *>(LazyCommitAlloc(sizeof(ItemT) * StackSize)))
+    {
+        if (_data == nullptr)
+            throw std::bad_alloc{};
+    }
+
+    ~Stack() { LazyCommitFree(_data, sizeof(ItemT) * StackSize); }
 
     Stack(const Stack &) = delete;
     Stack(Stack &&)      = delete;
@@ -6,17 +6,26 @@
 
 #include <chrono>
 #include <format>
-#include <unordered_map>
 #include <vector>
 
 #include "../include/Evaluation/BoardEvaluator.h"
 #include "../include/MoveGeneration/MoveGenerator.h"
+#include "../include/Search/MovePicker.h"
 #include "../include/Search/TranspositionTable.h"
-#include "../include/Search/ZobristHash.h"
 #include "../include/TestsAndDebugging/DebugTools.h"
 #include "../include/ThreadManagement/GameTimeManager.h"
 
-using RepMap = std::unordered_map<uint64_t, int>;
+/*
+ * Tables used by the helper threads to decide which iterations should be skipped.
+ * Helper threads are grouped, every group skips different set of depths,
+ * so the threads start searching different depths at the same time.
+ *
+ * References:
+ * - https://www.chessprogramming.org/Lazy_SMP
+ * */
+static constexpr size_t SkipTableSize         = 20;
+static constexpr int SkipSize[SkipTableSize]  = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+static constexpr int SkipPhase[SkipTableSize] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
 
 #ifndef NDEBUG
 
@@ -30,42 +39,25 @@ using RepMap = std::unordered_map<uint64_t, int>;
 #define TestTTAdd()
 #endif // NDEBUG
 
-[[nodiscard]] inline INLINE uint64_t
-ProcessAttackMove(Board &bd, const Move mv, const uint64_t hash, const VolatileBoardData &data)
+inline INLINE void ProcessAttackMove(Board &bd, const Move mv)
 {
-
-    const uint64_t nextHash = ZHasher.UpdateHash(hash, mv, data);
-    TTable.Prefetch(nextHash);
     Move::MakeMove(mv, bd);
-    bd.Repetitions[nextHash]++;
-
-    return nextHash;
+    TTable.Prefetch(bd.ZobristKey);
+    bd.PushRepetitionKey(bd.ZobristKey);
 }
 
-[[nodiscard]] inline INLINE uint64_t ProcessMove(
-    Board &bd, const Move mv, const int actualPly, const uint64_t hash, KillerTable &table,
-    const VolatileBoardData &data
-)
+inline INLINE void ProcessMove(Board &bd, const Move mv, const int actualPly, KillerTable &table)
 {
-
-    const uint64_t nextHash = ZHasher.UpdateHash(hash, mv, data);
-    TTable.Prefetch(nextHash);
     Move::MakeMove(mv, bd);
+    TTable.Prefetch(bd.ZobristKey);
     table.ClearPlyFloor(actualPly + 1);
-    bd.Repetitions[nextHash]++;
-
-    return nextHash;
+    bd.PushRepetitionKey(bd.ZobristKey);
 }
 
-[[nodiscard]] inline INLINE uint64_t
-RevertMove(Board &bd, const Move mv, const uint64_t hash, const VolatileBoardData &data)
+inline INLINE void RevertMove(Board &bd, const Move mv, const VolatileBoardData &data)
 {
     Move::UnmakeMove(mv, bd, data);
-
-    if (const int occurs = --bd.Repetitions[hash]; occurs == 0)
-        bd.Repetitions.erase(hash);
-
-    return ZHasher.UpdateHash(hash, mv, data);
+    bd.PopRepetitionKey();
 }
 
 int BestMoveSearch::IterativeDeepening(
@@ -76,16 +68,17 @@ int BestMoveSearch::IterativeDeepening(
     if (maxDepth == 0)
     {
         const int score = BoardEvaluator::DefaultFullEvalFunction(_board, _board.MovingColor);
-        GlobalLogger.LogStream << "info depth 0 score cp " << score << std::endl;
+
+        if (writeInfo)
+            GlobalLogger.LogStream << "info depth 0 score cp " << score << std::endl;
 
         return score;
     }
 
-    // Generate unique hash for the board
-    const uint64_t zHash = ZHasher.GenerateHash(_board);
     int32_t eval{};
     int32_t prevEval{};
     int64_t avg{};
+    _completedDepth = 0;
 
     // prepare pv buffer
     PV pvBuff{};
@@ -94,8 +87,16 @@ int BestMoveSearch::IterativeDeepening(
     const int range = std::min(maxDepth, MAX_SEARCH_DEPTH);
     for (int32_t depth = 1; depth <= range; ++depth)
     {
+        // helper threads skip some iterations, previous evaluation is used to keep aspiration window average stable
+        if (_shouldSkipDepth(depth))
+        {
+            avg += depth * prevEval;
+            continue;
+        }
+
         // Search start time point
         [[maybe_unused]] auto timeStart = GameTimeManager::GetCurrentTime();
+        [[maybe_unused]] const uint64_t totalNodesStart = writeInfo ? _getTotalNodes() : 0;
 
         // preparing variables used to display statistics
         _visitedNodes = 0;
@@ -111,7 +112,7 @@ int BestMoveSearch::IterativeDeepening(
 
             // performs the search without aspiration window to gather some initial statistics about the move
             eval = _search<SearchType::PVSearch, true>(
-                NEGATIVE_INFINITY - 1, POSITIVE_INFINITY + 1, depth * FULL_DEPTH_FACTOR, 0, zHash, {}, _pv, nullptr
+                NEGATIVE_INFINITY - 1, POSITIVE_INFINITY + 1, depth * FULL_DEPTH_FACTOR, 0, {}, _pv, nullptr
             );
             TraceIfFalse(_pv.IsFilled(), "PV buffer is not filled after the search!");
 
@@ -144,7 +145,7 @@ int BestMoveSearch::IterativeDeepening(
                 _histTable.ScaleTableDown();
                 _maxPlyReached = 0;
                 eval           = _search<SearchType::PVSearch, true>(
-                    alpha, beta, depth * FULL_DEPTH_FACTOR, 0, zHash, {}, pvBuff, nullptr
+                    alpha, beta, depth * FULL_DEPTH_FACTOR, 0, {}, pvBuff, nullptr
                 );
 
                 // if there was call to abort then abort
@@ -178,7 +179,8 @@ int BestMoveSearch::IterativeDeepening(
 
             // Display Asp Window statistics
             if constexpr (TestAsp)
-                stat.DisplayAndClean();
+                if (writeInfo)
+                    stat.DisplayAndClean();
 
             // if there was call to abort then abort
             if (std::abs(eval) == TIME_STOP_RESERVED_VALUE)
@@ -197,7 +199,11 @@ int BestMoveSearch::IterativeDeepening(
         if (std::abs(eval) == TIME_STOP_RESERVED_VALUE)
             break;
 
-        prevEval = eval;
+        prevEval        = eval;
+        _completedDepth = depth;
+
+        if (_collectTTStats)
+            _mergeStatistics();
 
         // Search stop time point
         [[maybe_unused]] auto timeStop = GameTimeManager::GetCurrentTime();
@@ -213,15 +219,17 @@ int BestMoveSearch::IterativeDeepening(
         // Log info if necessary
         if (writeInfo)
         {
-            const uint64_t spentMs  = std::max(static_cast<uint64_t>(1), (timeStop - timeStart).count() / MSEC_TO_NSEC);
-            const uint64_t nps      = 1000LLU * _visitedNodes / spentMs;
+            const auto spentTime    = std::chrono::duration_cast<std::chrono::milliseconds>(timeStop - timeStart);
+            const uint64_t spentMs  = std::max(static_cast<uint64_t>(1), static_cast<uint64_t>(spentTime.count()));
+            const uint64_t nodes    = _getTotalNodes() - totalNodesStart;
+            const uint64_t nps      = 1000LLU * nodes / spentMs;
             const double cutOffPerc = static_cast<double>(_cutoffNodes) / static_cast<double>(_visitedNodes);
 
             GlobalLogger.LogStream << std::format(
                 "info depth {} seldepth {} time {} nodes {} nps {} score cp {} currmove {} hashfull {} cut-offs perc "
                 "{:.2f} pv ",
-                depth, _maxPlyReached, spentMs, _visitedNodes, nps, IsMateScore(eval) ? eval : eval * SCORE_GRAIN,
-                _pv[0].GetLongAlgebraicNotation(), TTable.GetContainedElements(), cutOffPerc
+                depth, _maxPlyReached, spentMs, nodes, nps, IsMateScore(eval) ? eval : eval * SCORE_GRAIN,
+                _pv[0].GetLongAlgebraicNotation(), TTable.GetHashFull(), cutOffPerc
             );
 
             _pv.Print(eval == 0);
@@ -233,15 +241,81 @@ int BestMoveSearch::IterativeDeepening(
             break;
     }
 
-    if constexpr (TestTT)
-        TTable.DisplayStatisticsAndReset();
+    // statistics of aborted iteration
+    if (_collectTTStats)
+        _mergeStatistics();
 
     return prevEval;
 }
 
+uint64_t BestMoveSearch::_getTotalNodes() const
+{
+    uint64_t sum{};
+    for (size_t i = 0; i < _threadCount; ++i) sum += _nodeCounters[i].Nodes.load(std::memory_order_relaxed);
+    return sum;
+}
+
+void BestMoveSearch::_mergeStatistics()
+{
+    if (_pawnTable != nullptr)
+    {
+        _ttStats.PawnTable.probes += _pawnTable->GetProbes();
+        _ttStats.PawnTable.hits += _pawnTable->GetHits();
+        _pawnTable->ResetStatistics();
+    }
+
+    if (_materialTable != nullptr)
+    {
+        _ttStats.MaterialTable.probes += _materialTable->GetProbes();
+        _ttStats.MaterialTable.hits += _materialTable->GetHits();
+        _materialTable->ResetStatistics();
+    }
+
+    if (_evalCache != nullptr)
+    {
+        _ttStats.EvalCache.probes += _evalCache->GetProbes();
+        _ttStats.EvalCache.hits += _evalCache->GetHits();
+        _evalCache->ResetStatistics();
+    }
+
+    TTable.MergeStatistics(_ttStats);
+}
+
+int BestMoveSearch::_evaluate(const uint64_t zHash, const PositionInfo &info)
+{
+    int statEval;
+
+    if (_evalCache != nullptr && _evalCache->Probe(zHash, statEval))
+    {
+        // phase is saved by the evaluation itself and used later e.g. by the delta pruning
+        BoardEvaluator::PopulateLastPhase(_board);
+        return statEval;
+    }
+
+    statEval = BoardEvaluator::DefaultFullEvalFunction(_board, _board.MovingColor, info, _pawnTable, _materialTable);
+    TraceIfFalse(
+        statEval <= POSITIVE_INFINITY && statEval >= NEGATIVE_INFINITY, "Received suspicious static evaluation points!"
+    );
+
+    if (_evalCache != nullptr)
+        _evalCache->Store(zHash, statEval);
+
+    return statEval;
+}
+
+bool BestMoveSearch::_shouldSkipDepth(const int depth) const
+{
+    // main thread and first iteration are never skipped
+    if (_threadInd == 0 || depth == 1)
+        return false;
+
+    const size_t ind = (_threadInd - 1) % SkipTableSize;
+    return ((depth + _board.Age + SkipPhase[ind]) / SkipSize[ind]) % 2 != 0;
+}
+
 template <BestMoveSearch::SearchType searchType, bool followPv>
 int BestMoveSearch::_search(
-    int alpha, int beta, int depthLeft, int ply, uint64_t zHash, Move prevMove, PV &pv, PackedMove *bestMoveOut
+    int alpha, int beta, int depthLeft, int ply, Move prevMove, PV &pv, PackedMove *bestMoveOut
 )
 {
     static constexpr bool IsPvNode = searchType == SearchType::PVSearch;
@@ -262,54 +336,81 @@ int BestMoveSearch::_search(
     // last depth static eval needed or prev pv node value
     const int plyDepth = depthLeft / FULL_DEPTH_FACTOR;
     if (plyDepth <= 0)
-        return _qSearch<searchType>(alpha, beta, ply, zHash, 0);
+        return _qSearch<searchType>(alpha, beta, ply, 0);
 
     // incrementing nodes counter;
-    ++_visitedNodes;
+    _countNode();
 
     // Check whether we reached end of the legal path
     ChessMechanics mech{_board};
-    if (mech.IsDrawByReps(zHash))
+    if (mech.IsDrawByReps())
         return DRAW_SCORE;
 
     // reading Transposition table for the best move
+    const uint64_t zHash     = _board.ZobristKey;
     const auto prevSearchRes = TTable.GetRecord(zHash);
 
     // check whether hashes are same
     bool wasTTHit = prevSearchRes.IsSameHash(zHash);
 
-    if constexpr (TestTT)
-        TTable.UpdateStatistics(wasTTHit);
+    if (_collectTTStats)
+        _ttStats.RecordProbe(plyDepth, wasTTHit, prevSearchRes.GetNodeType());
 
     // Try to get a cut-off from tt record if the node is not pv node.
     // The depth must be higher than in actual node to get high quality score
     // Additionally when we are in singular search we do not use cutoffs to prevent misinformation spread
     if constexpr (!IsPvNode)
-        if (_excludedMove.IsEmpty() && wasTTHit && prevSearchRes.GetDepth() >= plyDepth)
+        if (_excludedMove.IsEmpty() && wasTTHit && prevSearchRes.GetDepth() >= plyDepth &&
+            _isTTCutoff(prevSearchRes, alpha, beta))
         {
-            if (prevSearchRes.GetNodeType() == PV_NODE)
-                return ++_cutoffNodes, prevSearchRes.GetAdjustedEval(ply);
+            if (_collectTTStats)
+                _ttStats.RecordCutoff(plyDepth, prevSearchRes.GetNodeType());
 
-            if (prevSearchRes.GetNodeType() == LOWER_BOUND && prevSearchRes.GetEval() >= beta)
-                return ++_cutoffNodes, prevSearchRes.GetAdjustedEval(ply);
-
-            if (prevSearchRes.GetNodeType() == UPPER_BOUND && prevSearchRes.GetEval() <= alpha)
-                return ++_cutoffNodes, prevSearchRes.GetAdjustedEval(ply);
+            return ++_cutoffNodes, prevSearchRes.GetAdjustedEval(ply);
         }
 
-    // generate moves
-    MoveGenerator mechanics(
-        _board, _stack, _histTable, _kTable, _cmTable.GetCounterMove(prevMove), ply, prevMove.GetTargetField()
-    );
-    auto moves = mechanics.GetMovesFast();
+    // selecting the move to be searched first, in pv nodes it is the move from previous ID (Iterative deepening)
+    // iteration, otherwise the best move saved inside the TT or found by IID
+    PackedMove hashMove{};
+    if (IsPvNode && followPv && _pv.Contains(ply))
+    {
+        // we follow only single PV we previously saved
+        hashMove = _pv[ply];
 
-    // If no move is possible: check whether we hit mate or stalemate
-    if (moves.size == 0)
-        return mechanics.IsCheck() ? GetMateValue(ply) : DRAW_SCORE;
+        // Extend pvs to detect changes earlier
+        if (ShouldExtend(ply, _rootDepth) && ply % 2 == 1)
+        {
+            depthLeft += PV_EXTENSION;
 
-    // Extends paths where we have only one move possible
+            if (TraceExtensions)
+                TraceWithInfo("Applied pv extension");
+        }
+    }
+    else if (!wasTTHit && _excludedMove.IsEmpty())
+    {
+        // try to save our situation by researching children using IID
+        if (plyDepth >= IID_MIN_DEPTH_PLY_DEPTH)
+            _search<searchType, false>(alpha, beta, depthLeft - IID_REDUCTION, ply, prevMove, pv, &hashMove);
+    }
+    else if (prevSearchRes.GetNodeType() != UPPER_BOUND && prevSearchRes.GetDepth() != 0)
+        // if we have any move saved from last time we visited that node and the move is valid try to use it
+        // NOTE: We don't store moves from fail low nodes only score so the move from fail low should always
+        // be empty
+        //       In other words we don't use best move from fail low nodes
+        hashMove = prevSearchRes.GetMove();
+
+    // occupancy, checks and pins are collected once and shared by the move generation and SEE
+    const PositionInfo info = mech.GetPositionInfo();
+
+    // moves are generated lazily, stage by stage, when they are requested
+    MovePicker picker(
+        _board, _stack, hashMove, MovePicker::Mode::AllMoves, _histTable, _kTable, _cmTable.GetCounterMove(prevMove), ply,
+        prevMove.GetTargetField(), &info
+    );
+
+    // Extends paths where we have only one move possible, number of moves is known only for evasions
     // TODO: consider do it other way to detect it also on leafs
-    if (ShouldExtend(ply, _rootDepth) && moves.size == 1)
+    if (ShouldExtend(ply, _rootDepth) && picker.IsCheck() && picker.GetEvasionsCount() == 1)
     {
         depthLeft += IsPvNode ? ONE_REPLY_EXTENSION_PV_NODE : ONE_REPLY_EXTENSION;
 
@@ -323,70 +424,22 @@ int BestMoveSearch::_search(
     int bestEval = NEGATIVE_INFINITY;
     PV inPV{};
 
-    // processing each move
-    for (size_t i = 0; i < moves.size; ++i)
+    // processing each move, 'i' counts the moves returned by the picker
+    size_t i = 0;
+    for (Move move = picker.GetNext(); !move.IsEmpty(); move = picker.GetNext(), ++i)
     {
-        if (i == 0)
-        {
-            if (IsPvNode && followPv && _pv.Contains(ply))
-            {
-                // first follow pv from previous ID (Iterative deepening) iteration,
-                // we follow only single PV we previously saved
-                _pullMoveToFront(moves, _pv[ply]);
-
-                // Extend pvs to detect changes earlier
-                if (ShouldExtend(ply, _rootDepth) && ply % 2 == 1)
-                {
-                    depthLeft += PV_EXTENSION;
-
-                    if (TraceExtensions)
-                        TraceWithInfo("Applied pv extension");
-                }
-            }
-            else
-            {
-                PackedMove prevBestMove{};
-                if (!wasTTHit && _excludedMove.IsEmpty())
-                {
-                    // try to save our situation by researching children using IID
-                    if (plyDepth >= IID_MIN_DEPTH_PLY_DEPTH)
-                        _search<searchType, false>(
-                            alpha, beta, depthLeft - IID_REDUCTION, ply, zHash, prevMove, pv, &prevBestMove
-                        );
-                }
-                else if (prevSearchRes.GetNodeType() != UPPER_BOUND && prevSearchRes.GetDepth() != 0)
-                    // if we have any move saved from last time we visited that node and the move is valid try to use it
-                    // NOTE: We don't store moves from fail low nodes only score so the move from fail low should always
-                    // be empty
-                    //       In other words we don't use best move from fail low nodes
-                    prevBestMove = prevSearchRes.GetMove();
-
-                if (!prevBestMove.IsEmpty())
-                    _pullMoveToFront(moves, prevBestMove);
-                else
-                    _fetchBestMove(moves, i);
-            }
-        }
-        else
-            _fetchBestMove(moves, i);
-
-        if (moves[i].GetPackedMove() == _excludedMove)
+        if (move.GetPackedMove() == _excludedMove)
             continue;
 
         int extensions{};
-        int seeValue = NEGATIVE_INFINITY;
 
         // ---------------------------- pruning -----------------------------------
         // we should avoid pruning when returning a mate score is possible
         if (ply > 0 && i != 0 && !IsMateScore(alpha))
         {
-            if (moves[i].IsAttackingMove() || moves[i].IsChecking())
-            {
-                seeValue = mechanics.SEE(moves[i]);
-
-                if (seeValue < (2 * SEE_GOOD_MOVE_BOUNDARY * plyDepth))
-                    continue;
-            }
+            if ((move.IsAttackingMove() || picker.IsGivingCheck(move)) &&
+                !picker.SEEGe(move, 2 * SEE_GOOD_MOVE_BOUNDARY * plyDepth))
+                continue;
         }
 
         // -------------------------- extensions --------------------------------
@@ -395,7 +448,7 @@ int BestMoveSearch::_search(
             // singular extensions:
             // we try to use entry from TT to determine whether given move is the only good move in this node,
             // if given thesis hold we extend proposed move search depth
-            if (ply > 0 && wasTTHit && _excludedMove.IsEmpty() && moves[i].GetPackedMove() == prevSearchRes.GetMove() &&
+            if (ply > 0 && wasTTHit && _excludedMove.IsEmpty() && move.GetPackedMove() == prevSearchRes.GetMove() &&
                 plyDepth - prevSearchRes.GetDepth() <= SINGULAR_EXTENSION_DEPTH_PROBE_LIMIT &&
                 (prevSearchRes.GetNodeType() == LOWER_BOUND || prevSearchRes.GetNodeType() == PV_NODE) &&
                 plyDepth > SINGULAR_EXTENSION_MIN_DEPTH)
@@ -409,7 +462,7 @@ int BestMoveSearch::_search(
                 // NOTE: due to single excluded move no recursive singular searched are allowed
                 _excludedMove           = prevSearchRes.GetMove();
                 const int singularValue = _search<SearchType::NoPVSearch, false>(
-                    singularBeta - 1, singularBeta, singularDepth, ply, zHash, prevMove, _dummyPv, nullptr
+                    singularBeta - 1, singularBeta, singularDepth, ply, prevMove, _dummyPv, nullptr
                 );
                 _excludedMove = PackedMove{};
 
@@ -418,20 +471,19 @@ int BestMoveSearch::_search(
                     extensions += SINGULAR_EXTENSION;
                 // Multi-cut pruning
                 else if (singularBeta >= beta)
-                {
-                    _stack.PopAggregate(moves);
                     return singularBeta;
-                }
             }
 
             // simple extensions deduction
-            extensions += _deduceExtensions(prevMove, moves[i], seeValue, IsPvNode);
+            extensions += _deduceExtensions(
+                prevMove, move, picker.IsGivingCheck(move) && picker.SEEGe(move, 1), IsPvNode
+            );
         }
 
         // stores the most recent return value of child trees,
         // alpha + 1 value enforces the second if trigger in first iteration in case of pv nodes
         int moveEval = alpha + 1;
-        zHash        = ProcessMove(_board, moves[i], ply, zHash, _kTable, oldData);
+        ProcessMove(_board, move, ply, _kTable);
 
         // In pv nodes we always search first move on full window due to assumption that TT will give
         // us best move that is possible.
@@ -439,7 +491,7 @@ int BestMoveSearch::_search(
         if (!IsPvNode || i != 0)
         {
             moveEval = -_search<SearchType::NoPVSearch, false>(
-                -(alpha + 1), -alpha, depthLeft - FULL_DEPTH_FACTOR + extensions, ply + 1, zHash, moves[i], _dummyPv,
+                -(alpha + 1), -alpha, depthLeft - FULL_DEPTH_FACTOR + extensions, ply + 1, move, _dummyPv,
                 nullptr
             );
         }
@@ -447,17 +499,17 @@ int BestMoveSearch::_search(
         // if not, research move only in case of pv nodes
         if (IsPvNode && alpha < moveEval)
         {
-            TTable.Prefetch(zHash);
+            TTable.Prefetch(_board.ZobristKey);
             _kTable.ClearPlyFloor(ply + 1);
 
             // Research with full window
             if (followPv && i == 0)
                 moveEval = -_search<SearchType::PVSearch, true>(
-                    -beta, -alpha, depthLeft - FULL_DEPTH_FACTOR, ply + 1, zHash, moves[i], inPV, nullptr
+                    -beta, -alpha, depthLeft - FULL_DEPTH_FACTOR, ply + 1, move, inPV, nullptr
                 );
             else
                 moveEval = -_search<SearchType::PVSearch, false>(
-                    -beta, -alpha, depthLeft - FULL_DEPTH_FACTOR, ply + 1, zHash, moves[i], inPV, nullptr
+                    -beta, -alpha, depthLeft - FULL_DEPTH_FACTOR, ply + 1, move, inPV, nullptr
                 );
         }
 
@@ -466,7 +518,7 @@ int BestMoveSearch::_search(
             return TIME_STOP_RESERVED_VALUE;
 
         // move reverted after possible research
-        zHash = RevertMove(_board, moves[i], zHash, oldData);
+        RevertMove(_board, move, oldData);
 
         // Check whether we should update values
         if (moveEval > bestEval)
@@ -474,13 +526,13 @@ int BestMoveSearch::_search(
             bestEval = moveEval;
             if (moveEval > alpha)
             {
-                bestMove = moves[i].GetPackedMove();
+                bestMove = move.GetPackedMove();
 
                 // cut-off found
                 if (moveEval >= beta)
                 {
-                    if (moves[i].IsQuietMove())
-                        _saveQuietMoveInfo(moves[i], prevMove, plyDepth, ply);
+                    if (move.IsQuietMove())
+                        _saveQuietMoveInfo(move, prevMove, plyDepth, ply);
 
                     ++_cutoffNodes;
                     break;
@@ -492,30 +544,36 @@ int BestMoveSearch::_search(
         }
     }
 
+    // If no move is possible: check whether we hit mate or stalemate,
+    // 'i' stays 0 also when the first move caused cut-off, but then the best eval is already updated
+    if (i == 0 && bestEval == NEGATIVE_INFINITY)
+        return picker.IsCheck() ? GetMateValue(ply) : DRAW_SCORE;
+
     // updating if profitable
-    if (_excludedMove.IsEmpty() && (plyDepth >= prevSearchRes.GetDepth() ||
-                                    (!wasTTHit && _board.Age - prevSearchRes.GetAge() >= DEFAULT_AGE_DIFF_REPLACE)))
+    // replacement inside the bucket is decided by the table itself
+    if (_excludedMove.IsEmpty() && (!wasTTHit || plyDepth >= prevSearchRes.GetDepth()))
     {
         const NodeType nType = (bestEval >= beta ? LOWER_BOUND : bestMove.IsEmpty() ? UPPER_BOUND : PV_NODE);
 
         const TranspositionTable::HashRecord record{
-            zHash,    bestMove, bestEval,   wasTTHit ? prevSearchRes.GetStatVal() : NO_EVAL_RESERVED_VALUE,
-            plyDepth, nType,    _board.Age, ply
+            zHash, bestMove, bestEval, wasTTHit ? prevSearchRes.GetStatVal() : NO_EVAL_RESERVED_VALUE,
+            plyDepth, nType, ply
         };
 
-        TTable.Add(record, zHash);
+        const bool wasOverwrite = TTable.Add(record, zHash);
+
+        if (_collectTTStats)
+            _ttStats.RecordStore(plyDepth, nType, wasOverwrite);
     }
 
     if (bestMoveOut != nullptr)
         *bestMoveOut = bestMove;
 
-    // clean up
-    _stack.PopAggregate(moves);
     return bestEval;
 }
 
 template <BestMoveSearch::SearchType searchType>
-int BestMoveSearch::_qSearch(int alpha, int beta, int ply, uint64_t zHash, int extendedDepth)
+int BestMoveSearch::_qSearch(int alpha, int beta, int ply, int extendedDepth)
 {
     static constexpr bool IsPvNode = searchType == SearchType::PVSearch;
     TraceIfFalse(beta > alpha, "Beta is not greater than alpha");
@@ -527,27 +585,31 @@ int BestMoveSearch::_qSearch(int alpha, int beta, int ply, uint64_t zHash, int e
         return TIME_STOP_RESERVED_VALUE;
 
     // incrementing nodes counter
-    ++_visitedNodes;
+    _countNode();
 
     // Check whether we reached end of the legal path
     ChessMechanics mech{_board};
-    if (mech.IsDrawByReps(zHash))
+    if (mech.IsDrawByReps())
         return DRAW_SCORE;
 
     int bestEval = NEGATIVE_INFINITY;
     int statEval = NO_EVAL_RESERVED_VALUE;
-    MoveGenerator::payload moves;
 
     // reading Transposition table for the best move
-    auto &prevSearchRes = TTable.GetRecord(zHash);
+    const uint64_t zHash     = _board.ZobristKey;
+    const auto prevSearchRes = TTable.GetRecord(zHash);
 
     // We got a hit
     const bool wasTTHit = prevSearchRes.IsSameHash(zHash);
 
+    if (_collectTTStats)
+        _ttStats.RecordProbe(0, wasTTHit, prevSearchRes.GetNodeType());
+
     // When we have a check we cannot use static evaluation at all due to possible dangers that may happen
-    // that means we should resolve most of the lines with checks
-    MoveGenerator mechanics(_board, _stack);
-    const bool isCheck = mechanics.IsCheck();
+    // that means we should resolve most of the lines with checks.
+    // Occupancy, checks and pins are collected once and shared by the evaluation, the move generation and SEE
+    const PositionInfo info = mech.GetPositionInfo();
+    const bool isCheck      = info.IsCheck();
 
     // Avoid static evaluation when king is checked
     if (!isCheck)
@@ -556,16 +618,13 @@ int BestMoveSearch::_qSearch(int alpha, int beta, int ply, uint64_t zHash, int e
         {
             // Check for tt cut-off in case of zw quiesce search
             if constexpr (!IsPvNode)
-            {
-                if (prevSearchRes.GetNodeType() == PV_NODE)
-                    return ++_cutoffNodes, prevSearchRes.GetAdjustedEval(ply + extendedDepth);
-
-                if (prevSearchRes.GetNodeType() == LOWER_BOUND && prevSearchRes.GetEval() >= beta)
-                    return ++_cutoffNodes, prevSearchRes.GetAdjustedEval(ply + extendedDepth);
+                if (_isTTCutoff(prevSearchRes, alpha, beta))
+                {
+                    if (_collectTTStats)
+                        _ttStats.RecordCutoff(0, prevSearchRes.GetNodeType());
 
-                if (prevSearchRes.GetNodeType() == UPPER_BOUND && prevSearchRes.GetEval() <= alpha)
                     return ++_cutoffNodes, prevSearchRes.GetAdjustedEval(ply + extendedDepth);
-            }
+                }
 
             // Try to read from tt previously calculated static evaluation
             if (prevSearchRes.GetStatVal() != NO_EVAL_RESERVED_VALUE)
@@ -576,18 +635,13 @@ int BestMoveSearch::_qSearch(int alpha, int beta, int ply, uint64_t zHash, int e
             else
             {
                 // otherwise calculate the static eval
-                statEval = BoardEvaluator::DefaultFullEvalFunction(_board, _board.MovingColor);
-                TraceIfFalse(
-                    statEval <= POSITIVE_INFINITY && statEval >= NEGATIVE_INFINITY,
-                    "Received suspicious static evaluation points!"
-                );
-
-                prevSearchRes.SetStatVal(statEval);
+                statEval = _evaluate(zHash, info);
+                TTable.SetStatVal(zHash, statEval);
             }
         }
         else
             // again no tt entry calculate eval
-            statEval = BoardEvaluator::DefaultFullEvalFunction(_board, _board.MovingColor);
+            statEval = _evaluate(zHash, info);
 
         // check for stand-pat cut-off
         bestEval = statEval;
@@ -598,55 +652,53 @@ int BestMoveSearch::_qSearch(int alpha, int beta, int ply, uint64_t zHash, int e
 
             alpha = bestEval;
         }
-
-        moves = mechanics.GetMovesFast<true>();
     }
-    else
-    {
-        // When there is check we need to go through every possible move to get a better view about the position
-        moves = mechanics.GetMovesFast();
 
-        if (moves.size == 0)
-            return mechanics.IsCheck() ? GetMateValue(ply + extendedDepth) : DRAW_SCORE;
-    }
+    // Empty move cannot be a capture move se we are sure that valid move is saved
+    const PackedMove hashMove =
+        wasTTHit && ((prevSearchRes.GetNodeType() != UPPER_BOUND && isCheck) || prevSearchRes.GetMove().IsCapture())
+            ? prevSearchRes.GetMove()
+            : PackedMove{};
+
+    // When there is check we need to go through every possible move to get a better view about the position,
+    // otherwise only the captures that passed SEE test are returned, on the first ply followed by quiet checks
+    const MovePicker::Mode mode = UseQSearchChecks && extendedDepth == 0 ? MovePicker::Mode::CapturesAndQuietChecks
+                                                                         : MovePicker::Mode::Captures;
+    MovePicker picker(_board, _stack, hashMove, mode, _histTable, _kTable, {}, ply, 0, &info);
 
     // saving volatile fields
     VolatileBoardData oldData{_board};
     PackedMove bestMove{};
 
-    // Empty move cannot be a capture move se we are sure that valid move is saved
-    if (wasTTHit && ((prevSearchRes.GetNodeType() != UPPER_BOUND && isCheck) || prevSearchRes.GetMove().IsCapture()))
-        _pullMoveToFront(moves, prevSearchRes.GetMove());
-    else
-        _fetchBestMove(moves, 0);
-
     // iterating through moves
-    for (size_t i = 0; i < moves.size; ++i)
+    size_t i = 0;
+    for (Move move = picker.GetNext(); !move.IsEmpty(); move = picker.GetNext(), ++i)
     {
-        if (i != 0)
-            _fetchBestMove(moves, i);
-
         // pruning on the move
         if (!isCheck)
         {
-            const int SEEValue = mech.SEE(moves[i]);
-            /*                  DELTA PRUNING                              */
+            /*                  SEE capture value estimation                */
+            int seeThreshold = SEE_GOOD_MOVE_BOUNDARY;
 
-            // Increase delta in case of promotion
-            int delta = statEval + DELTA_PRUNING_SAFETY_MARGIN + SEEValue +
-                        (moves[i].GetPackedMove().IsPromo() ? DELTA_PRUNING_PROMO : 0);
+            /*                  DELTA PRUNING                              */
 
-            if (statEval + delta < alpha && !_board.IsEndGame())
-                continue;
+            // Move is pruned when statEval + delta < alpha, where delta = statEval + margin + SEE, so both tests
+            // are merged into single SEE threshold. Increase delta in case of promotion,
+            // quiet checks do not gain material and are not pruned that way
+            if (!move.IsQuietMove() && !_board.IsEndGame())
+            {
+                const int deltaBase = statEval + DELTA_PRUNING_SAFETY_MARGIN +
+                                      (move.GetPackedMove().IsPromo() ? DELTA_PRUNING_PROMO : 0);
+                seeThreshold = std::max(seeThreshold, alpha - statEval - deltaBase);
+            }
 
-            /*                  SEE capture value estimation                */
-            if (SEEValue < SEE_GOOD_MOVE_BOUNDARY)
+            if (!picker.SEEGe(move, seeThreshold))
                 continue;
         }
 
-        zHash               = ProcessAttackMove(_board, moves[i], zHash, oldData);
-        const int moveValue = -_qSearch<searchType>(-beta, -alpha, ply + 1, zHash, extendedDepth + 1);
-        zHash               = RevertMove(_board, moves[i], zHash, oldData);
+        ProcessAttackMove(_board, move);
+        const int moveValue = -_qSearch<searchType>(-beta, -alpha, ply + 1, extendedDepth + 1);
+        RevertMove(_board, move, oldData);
 
         // if there was call to abort then abort
         if (std::abs(moveValue) == TIME_STOP_RESERVED_VALUE)
@@ -657,7 +709,7 @@ int BestMoveSearch::_qSearch(int alpha, int beta, int ply, uint64_t zHash, int e
             bestEval = moveValue;
             if (moveValue > alpha)
             {
-                bestMove = moves[i].GetPackedMove();
+                bestMove = move.GetPackedMove();
                 if (moveValue >= beta)
                 {
                     ++_cutoffNodes;
@@ -669,90 +721,36 @@ int BestMoveSearch::_qSearch(int alpha, int beta, int ply, uint64_t zHash, int e
         }
     }
 
-    if (!isCheck && !wasTTHit &&
-        (prevSearchRes.GetDepth() == 0 || _board.Age - prevSearchRes.GetAge() >= QUIESENCE_AGE_DIFF_REPLACE))
-    {
-        const NodeType nType = (bestEval >= beta ? LOWER_BOUND : bestMove.IsEmpty() ? UPPER_BOUND : PV_NODE);
-
-        const TranspositionTable::HashRecord record{zHash, bestMove, bestEval,   statEval,
-                                                    0,     nType,    _board.Age, ply + extendedDepth};
-        TTable.Add(record, zHash);
-    }
-
-    // clean up
-    _stack.PopAggregate(moves);
-    return bestEval;
-}
-
-void BestMoveSearch::_pullMoveToFront(MoveGenerator::payload moves, const PackedMove mv)
-{
-    TraceIfFalse(mv.IsOkeyMove(), "Given move to find is a null move!");
-
-    // preparing sentinel
-    const Move sentinelOld = moves.data[moves.size];
-    moves.data[moves.size] = Move(mv);
-
-    // finding stopping index
-    size_t ind = 0;
-    while (moves.data[ind] != Move(mv)) ind++;
+    // checked king without any evasion means mate
+    if (isCheck && i == 0 && bestEval == NEGATIVE_INFINITY)
+        return GetMateValue(ply + extendedDepth);
 
-    // replacing old element
-    moves.data[moves.size] = sentinelOld;
-
-    // if move found swapping
-    if (ind != moves.size)
+    if (!isCheck && !wasTTHit)
     {
-        auto bestMove = moves.data[ind];
-        for (signed_size_t i = static_cast<signed_size_t>(ind) - 1; i >= 0; --i) moves.data[i + 1] = moves.data[i];
-        moves.data[0] = bestMove;
-        return;
-    }
-
-    WrapTraceMsgError("Move stored inside the TT was not found in the moves list!");
-}
+        const NodeType nType = (bestEval >= beta ? LOWER_BOUND : bestMove.IsEmpty() ? UPPER_BOUND : PV_NODE);
 
-void BestMoveSearch::_fetchBestMove(MoveGenerator::payload moves, const size_t targetPos)
-{
-    int maxValue  = NEGATIVE_INFINITY;
-    size_t maxInd = targetPos;
+        const TranspositionTable::HashRecord record{zHash, bestMove, bestEval, statEval,
+                                                    0,     nType,    ply + extendedDepth};
+        const bool wasOverwrite = TTable.Add(record, zHash);
 
-    for (size_t i = targetPos; i < moves.size; ++i)
-    {
-        if (const int heuristicEval = moves[i].GetEval(); heuristicEval > maxValue)
-        {
-            maxInd   = i;
-            maxValue = heuristicEval;
-        }
+        if (_collectTTStats)
+            _ttStats.RecordStore(0, nType, wasOverwrite);
     }
 
-    const auto signedTargetPos = static_cast<signed_size_t>(targetPos);
-    auto bestMove              = moves.data[maxInd];
-    for (signed_size_t i = static_cast<signed_size_t>(maxInd) - 1; i >= signedTargetPos; --i)
-        moves.data[i + 1] = moves.data[i];
-    moves.data[targetPos] = bestMove;
-
-    TraceIfFalse(
-        maxInd == targetPos || moves.data[targetPos].GetEval() >= moves.data[targetPos + 1].GetEval(),
-        "Move sorting failed!"
-    );
+    return bestEval;
 }
 
 int BestMoveSearch::QuiesceEval()
 {
-    uint64_t hash = ZHasher.GenerateHash(_board);
-
-    return _qSearch<SearchType::PVSearch>(NEGATIVE_INFINITY, POSITIVE_INFINITY, 0, hash, 0);
+    return _qSearch<SearchType::PVSearch>(NEGATIVE_INFINITY, POSITIVE_INFINITY, 0, 0);
 }
 
-int BestMoveSearch::_deduceExtensions(Move prevMove, Move actMove, const int seeValue, const bool isPv)
+int BestMoveSearch::_deduceExtensions(Move prevMove, Move actMove, const bool isWinningCheck, const bool isPv)
 {
     int rv{};
 
-    ChessMechanics mech{_board};
-    // check extensions
-
-    rv += (actMove.IsChecking() && (seeValue == NEGATIVE_INFINITY ? mech.SEE(actMove) : seeValue) > 0) *
-          (isPv ? CHECK_EXTENSION_PV_NODE : CHECK_EXTENSION);
+    // check extensions, only for checks winning material
+    rv += isWinningCheck * (isPv ? CHECK_EXTENSION_PV_NODE : CHECK_EXTENSION);
     if (TraceExtensions && rv != 0)
         TraceWithInfo("Applied check extension");
 
@@ -26,5 +26,17 @@ bool Board::Comp(const Board &a, const Board &b)
     if (a.MovingColor != b.MovingColor)
         return false;
 
+    if (a.PieceOnSquare != b.PieceOnSquare)
+    {
+        GlobalLogger.LogStream << "Invalid mailbox\n";
+        return false;
+    }
+
+    if (a.PsqtMidgame != b.PsqtMidgame || a.PsqtEndgame != b.PsqtEndgame || a.PhaseWeights != b.PhaseWeights)
+    {
+        GlobalLogger.LogStream << "Invalid evaluation sums\n";
+        return false;
+    }
+
     return true;
 }
@@ -8,8 +8,26 @@
 #include "../include/Engine.h"
 #include "../include/Interface/UCITranslator.h"
 
+// Verifies whether the running cpu supports all instructions the engine was built with
+static bool IsCpuSupported()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (UsePextMaps)
+        if (!__builtin_cpu_supports("bmi2"))
+        {
+            GlobalLogger.LogStream << "[ ERROR ] Engine was built with PEXT maps, but the cpu does not support BMI2!\n";
+            return false;
+        }
+#endif
+
+    return true;
+}
+
 void ChessEngineMainEntry(const int argc, const char **argv)
 {
+    if (!IsCpuSupported())
+        return;
+
     // Start the time manager
     GameTimeManager::StartTimerAsync();
 
@@ -52,115 +52,98 @@ bool ChessMechanics::IsCheck() const
 }
 
 /*      IMPORTANT NOTES:
- *  BlockedFieldsMap - indicates wheter some field could be attacked by enemy figures in their next round.
- *  During generation process there are check test performed with counting, what yields 3 code branches inside main
- *  generation code. Map is mainly used when king is moving, allowing to simply predict wheter king should
+ *  BlockedFields - indicates whether some field could be attacked by enemy figures in their next round.
+ *  Checkers are counted here, what yields 3 code branches inside main generation code: no-check, single-check and
+ *  double-check. Blocked map is mainly used when king is moving, allowing to simply predict whether king should
  *  move to that tile or not.
  *
  */
 
-std::tuple<uint64_t, uint8_t, uint8_t> ChessMechanics::GetBlockedFieldBitMap(uint64_t fullMap) const
+PositionInfo ChessMechanics::GetPositionInfo() const
 {
-    TraceIfFalse(fullMap != 0, "Full map is empty!");
+    PositionInfo info{};
+
+    const int enemyCol          = SwapColor(_board.MovingColor);
+    const size_t enemyFigInd    = enemyCol * Board::BitBoardsPerCol;
+    const int allyKingPos       = _board.GetKingMsbPos(_board.MovingColor);
+    const uint64_t allyKingMap  = MaxMsbPossible >> allyKingPos;
+    const uint64_t enemyPawns   = _board.BitBoards[enemyFigInd + pawnsIndex];
+    const uint64_t enemyKnights = _board.BitBoards[enemyFigInd + knightsIndex];
+    const uint64_t enemyBishops = _board.BitBoards[enemyFigInd + bishopsIndex];
+    const uint64_t enemyRooks   = _board.BitBoards[enemyFigInd + rooksIndex];
+    const uint64_t enemyQueens  = _board.BitBoards[enemyFigInd + queensIndex];
+
+    info.ColorMaps = {GetColBitMap(WHITE), GetColBitMap(BLACK)};
+    info.FullMap   = info.ColorMaps[WHITE] | info.ColorMaps[BLACK];
+
+    CollectAttacks(info, enemyCol);
+    for (const uint64_t attacks : info.Attacks[enemyCol]) info.BlockedFields |= attacks;
+
+    // enemy figures seen from the king perspective are the checking ones, double check is possible only when
+    // the second checker is uncovered or created by promotion
+    const uint64_t kingPawnPerspective = _board.MovingColor == WHITE ? WhitePawnMap::GetAttackFields(allyKingMap)
+                                                                     : BlackPawnMap::GetAttackFields(allyKingMap);
+    const uint64_t simpleCheckers =
+        (KnightMap::GetMoves(allyKingPos) & enemyKnights) | (kingPawnPerspective & enemyPawns);
+    const uint64_t slidingCheckers = (BishopMap::GetMoves(allyKingPos, info.FullMap) & (enemyBishops | enemyQueens)) |
+                                     (RookMap::GetMoves(allyKingPos, info.FullMap) & (enemyRooks | enemyQueens));
+
+    info.Checkers    = simpleCheckers | slidingCheckers;
+    info.ChecksCount = static_cast<uint8_t>(CountOnesInBoard(info.Checkers));
+    info.CheckType   = simpleCheckers != 0 ? simpleFigCheck : slidingFigCheck;
+
+    // pins of the side not to move are needed by the evaluation only, so it collects them itself
+    info.PinnedFigs = GetPinnedFigsMap<PinnedFigGen::WoutAllowedTiles>(_board.MovingColor, info.FullMap).first;
+
+    return info;
+}
 
-    uint8_t checksCount{};
-    uint8_t chT{};
+void ChessMechanics::CollectAttacks(PositionInfo &info, const int col) const
+{
+    TraceIfFalse(info.FullMap != 0, "Full map is empty!");
 
-    const int enemyCol         = SwapColor(_board.MovingColor);
-    const size_t enemyFigInd   = enemyCol * Board::BitBoardsPerCol;
-    const int allyKingShift    = ConvertToReversedPos(_board.GetKingMsbPos(_board.MovingColor));
-    const uint64_t allyKingMap = 1LLU << allyKingShift;
+    const size_t figInd  = col * Board::BitBoardsPerCol;
+    const uint64_t pawns = _board.BitBoards[figInd + pawnsIndex];
+    auto &attacks        = info.Attacks[col];
 
     // allows to also simply predict which tiles on the other side of the king are allowed.
-    const uint64_t fullMapWoutKing = fullMap ^ allyKingMap;
+    const uint64_t fullMapWoutKing = info.FullMap ^ (MaxMsbPossible >> _board.GetKingMsbPos(SwapColor(col)));
 
-    // King attacks generation.
-    const uint64_t kingBlockedMap = KingMap::GetMoves(_board.GetKingMsbPos(enemyCol));
+    attacks[pawnsIndex] = col == WHITE ? WhitePawnMap::GetAttackFields(pawns) : BlackPawnMap::GetAttackFields(pawns);
 
-    // Rook attacks generation. Needs special treatment to correctly detect double check, especially with pawn promotion
-    const auto [rookBlockedMap, checkCountRook] = _getRookBlockedMap(
-        _board.BitBoards[enemyFigInd + rooksIndex] | _board.BitBoards[enemyFigInd + queensIndex], fullMapWoutKing,
-        allyKingMap
+    attacks[knightsIndex] = _blockIterativeGenerator(
+        _board.BitBoards[figInd + knightsIndex],
+        [](const int pos)
+        {
+            return KnightMap::GetMoves(pos);
+        }
     );
 
-    // = 0, 1 or eventually 2 when promotion to rook like type happens
-    checksCount += checkCountRook;
-
-    // Bishop attacks generation.
-    const uint64_t bishopBlockedMap = _blockIterativeGenerator(
-        _board.BitBoards[enemyFigInd + bishopsIndex] | _board.BitBoards[enemyFigInd + queensIndex],
+    attacks[bishopsIndex] = _blockIterativeGenerator(
+        _board.BitBoards[figInd + bishopsIndex],
         [=](const int pos)
         {
             return BishopMap::GetMoves(pos, fullMapWoutKing);
         }
     );
 
-    // = 1 or 0 depending whether hits or not
-    const uint8_t wasCheckedByBishopFlag = (bishopBlockedMap & allyKingMap) >> allyKingShift;
-    checksCount += wasCheckedByBishopFlag;
-
-    // Pawns attacks generation.
-    const uint64_t pawnsMap = _board.BitBoards[enemyFigInd + pawnsIndex];
-    const uint64_t pawnBlockedMap =
-        enemyCol == WHITE ? WhitePawnMap::GetAttackFields(pawnsMap) : BlackPawnMap::GetAttackFields(pawnsMap);
-
-    // = 1 or 0 depending whether hits or not
-    const uint8_t wasCheckedByPawnFlag = (pawnBlockedMap & allyKingMap) >> allyKingShift;
-    checksCount += wasCheckedByPawnFlag;
-
-    // modyfing check type
-    chT += simpleFigCheck * wasCheckedByPawnFlag; // Note: king cannot be double checked by simple figure
-
-    // Knight attacks generation.
-    const uint64_t knighBlockedMap = _blockIterativeGenerator(
-        _board.BitBoards[enemyFigInd + knightsIndex],
+    attacks[rooksIndex] = _blockIterativeGenerator(
+        _board.BitBoards[figInd + rooksIndex],
         [=](const int pos)
         {
-            return KnightMap::GetMoves(pos);
+            return RookMap::GetMoves(pos, fullMapWoutKing);
         }
     );
 
-    // = 1 or 0 depending whether hits or not
-    const uint8_t wasCheckedByKnightFlag = (knighBlockedMap & allyKingMap) >> allyKingShift;
-    checksCount += wasCheckedByKnightFlag;
-
-    // modyfing check type
-    chT += simpleFigCheck * wasCheckedByKnightFlag; // Note: king cannot be double checked by simple figure
-
-    const uint64_t blockedMap = kingBlockedMap | pawnBlockedMap | knighBlockedMap | rookBlockedMap | bishopBlockedMap;
-    return {blockedMap, checksCount, chT};
-}
-
-uint64_t ChessMechanics::GetAllowedTilesWhenCheckedByNonSliding() const
-{
-    uint64_t allowedTiles{};
-
-    allowedTiles |= KingMap::GetSimpleFigCheckKnightsAllowedTiles(_board);
-    allowedTiles |= KingMap::GetSimpleFigCheckPawnAllowedTiles(_board);
-
-    return allowedTiles;
-}
-
-std::pair<uint64_t, uint8_t>
-ChessMechanics::_getRookBlockedMap(uint64_t rookMap, const uint64_t fullMapWoutKing, const uint64_t kingMap)
-{
-    TraceIfFalse(kingMap != 0, "King map is empty!");
-
-    uint64_t blockedTiles{};
-    uint8_t checks{};
-
-    while (rookMap)
-    {
-        const int msbPos = ExtractMsbPos(rookMap);
-
-        const uint64_t moves = RookMap::GetMoves(msbPos, fullMapWoutKing);
-        blockedTiles |= moves;
-        checks += ((moves & kingMap) != 0);
-
-        rookMap ^= MaxMsbPossible >> msbPos;
-    }
+    attacks[queensIndex] = _blockIterativeGenerator(
+        _board.BitBoards[figInd + queensIndex],
+        [=](const int pos)
+        {
+            return BishopMap::GetMoves(pos, fullMapWoutKing) | RookMap::GetMoves(pos, fullMapWoutKing);
+        }
+    );
 
-    return {blockedTiles, checks};
+    attacks[kingIndex] = KingMap::GetMoves(_board.GetKingMsbPos(col));
 }
 
 uint64_t ChessMechanics::GenerateAllowedTilesForPrecisedPinnedFig(const uint64_t figBoard, const uint64_t fullMap) const
@@ -179,16 +162,10 @@ uint64_t ChessMechanics::GenerateAllowedTilesForPrecisedPinnedFig(const uint64_t
     return BishopPerspectiveMoves & BishopMap::GetMoves(ExtractMsbPos(KingBoard), fullMap ^ figBoard);
 }
 
-int ChessMechanics::SEE(const Move mv) const
+int ChessMechanics::_see(const Move mv, const uint64_t fullMapBeforeMove) const
 {
-    static constexpr uint64_t (*moveGenerators[])(
-        int, uint64_t, uint64_t
-    ){WhitePawnMap::GetMoves, KnightMap::GetMoves, BishopMap::GetMoves, RookMap::GetMoves, QueenMap::GetMoves, nullptr,
-      BlackPawnMap::GetMoves, KnightMap::GetMoves, BishopMap::GetMoves, RookMap::GetMoves, QueenMap::GetMoves, nullptr};
-
     // limited by figures possible figures on the board
     static constexpr size_t MaximalFigureCount = 32;
-    static constexpr int CheckPoints           = 200;
 
     int scores[MaximalFigureCount];
     int depth = 0;
@@ -196,7 +173,7 @@ int ChessMechanics::SEE(const Move mv) const
     // bitboard used to store field from which last attack came
     uint64_t attackFromBitBoard = MaxMsbPossible >> mv.GetStartField();
     // perform preparation for SEE, refer to _prepareForSEE for details
-    auto [attackersBitBoard, fullMap, xray] = _prepareForSEE(mv.GetTargetField());
+    auto [attackersBitBoard, fullMap, xray] = _prepareForSEE(mv.GetTargetField(), fullMapBeforeMove);
 
     int attackerFigType = mv.GetStartBoardIndex();
     int color           = _board.MovingColor;
@@ -208,10 +185,6 @@ int ChessMechanics::SEE(const Move mv) const
         // sum up points
         scores[depth] = BoardEvaluator::ColorlessBasicFigureValues[attackerFigType] - scores[depth - 1];
 
-        //        // try to get a cut-off
-        //        if (std::max(-scores[depth - 1], scores[depth]) < 0)
-        //            break;
-
         // pseudo make move - remove figure from attackers and from the full map
         attackersBitBoard ^= attackFromBitBoard;
         fullMap ^= attackFromBitBoard;
@@ -225,29 +198,101 @@ int ChessMechanics::SEE(const Move mv) const
     } while (attackFromBitBoard);
 
     // add some bonus when finally king is left under the check
-    if (attackerFigType != wKingIndex && attackerFigType != bKingIndex)
+    scores[depth - 1] += _seeCheckBonus(attackerFigType, color, mv.GetTargetField(), fullMap);
+
+    while (--depth) scores[depth - 1] = -std::max(-scores[depth - 1], scores[depth]);
+    return scores[0] / SCORE_GRAIN;
+}
+
+bool ChessMechanics::_seeGe(const Move mv, const uint64_t fullMapBeforeMove, const int threshold) const
+{
+    // exact SEE is truncated towards zero after division by SCORE_GRAIN, threshold is translated to raw points
+    const int rawThreshold = threshold > 0 ? threshold * SCORE_GRAIN : (threshold - 1) * SCORE_GRAIN + 1;
+
+    // result is decided without looking at other attackers, when even the best or the worst case for the moving side,
+    // keeping the captured figure or losing the attacker, both with the check bonus, is on one side of the threshold
+    const int victimValue   = BoardEvaluator::ColorlessBasicFigureValues[mv.GetKilledBoardIndex()];
+    const int attackerValue = BoardEvaluator::ColorlessBasicFigureValues[mv.GetStartBoardIndex()];
+    if (victimValue + SeeCheckPoints < rawThreshold)
+        return false;
+    if (victimValue - attackerValue - SeeCheckPoints >= rawThreshold)
+        return true;
+
+    uint64_t attackFromBitBoard             = MaxMsbPossible >> mv.GetStartField();
+    auto [attackersBitBoard, fullMap, xray] = _prepareForSEE(mv.GetTargetField(), fullMapBeforeMove);
+
+    int attackerFigType = mv.GetStartBoardIndex();
+    int color           = _board.MovingColor;
+
+    // material balance of the moving side after the last capture and whether that capture was done by it
+    int balance            = victimValue;
+    bool isMoverLastToMove = true;
+
+    while (true)
     {
-        auto func                = moveGenerators[attackerFigType];
-        const uint64_t enemyKing = _board.BitBoards[color * Board::BitBoardsPerCol + kingIndex];
-        const uint64_t attacks   = func(mv.GetTargetField(), fullMap, enemyKing);
+        // figure standing on the target field, which may be recaptured now
+        const int onTargetType  = attackerFigType;
+        const int onTargetValue = BoardEvaluator::ColorlessBasicFigureValues[onTargetType];
+
+        // pseudo make move - remove figure from attackers and from the full map
+        attackersBitBoard ^= attackFromBitBoard;
+        fullMap ^= attackFromBitBoard;
 
-        scores[depth - 1] += CheckPoints * ((attacks & enemyKing) != 0);
+        if (attackFromBitBoard & xray)
+            attackersBitBoard |= _updateAttackers(fullMap, mv.GetTargetField());
+
+        color              = SwapColor(color);
+        attackFromBitBoard = getLeastValuablePieceFromLegalToSquare(fullMap, attackersBitBoard, color, attackerFigType);
+
+        // nobody can recapture, the exchange ends here
+        if (!attackFromBitBoard)
+        {
+            const int bonus = _seeCheckBonus(onTargetType, color, mv.GetTargetField(), fullMap);
+            return balance + (isMoverLastToMove ? bonus : -bonus) >= rawThreshold;
+        }
+
+        // side able to recapture may stop the exchange when the result is already decided in its favor
+        const bool isAboveThreshold = balance >= rawThreshold;
+        if (isAboveThreshold != isMoverLastToMove)
+            return isAboveThreshold;
+
+        // recapturing is not worth it when even keeping the figure with the check bonus does not change the result
+        balance += isMoverLastToMove ? -onTargetValue : onTargetValue;
+        if (isMoverLastToMove && balance - SeeCheckPoints >= rawThreshold)
+            return true;
+        if (!isMoverLastToMove && balance + SeeCheckPoints < rawThreshold)
+            return false;
+
+        isMoverLastToMove = !isMoverLastToMove;
     }
+}
 
-    while (--depth) scores[depth - 1] = -std::max(-scores[depth - 1], scores[depth]);
-    return scores[0] / SCORE_GRAIN;
+int ChessMechanics::_seeCheckBonus(
+    const int lastAttackerType, const int enemyColor, const int msbPos, const uint64_t fullMap
+) const
+{
+    static constexpr uint64_t (*moveGenerators[])(
+        int, uint64_t, uint64_t
+    ){WhitePawnMap::GetMoves, KnightMap::GetMoves, BishopMap::GetMoves, RookMap::GetMoves, QueenMap::GetMoves, nullptr,
+      BlackPawnMap::GetMoves, KnightMap::GetMoves, BishopMap::GetMoves, RookMap::GetMoves, QueenMap::GetMoves, nullptr};
+
+    if (lastAttackerType == wKingIndex || lastAttackerType == bKingIndex)
+        return 0;
+
+    const uint64_t enemyKing = _board.BitBoards[enemyColor * Board::BitBoardsPerCol + kingIndex];
+    const uint64_t attacks   = moveGenerators[lastAttackerType](msbPos, fullMap, enemyKing);
+
+    return SeeCheckPoints * ((attacks & enemyKing) != 0);
 }
 
-ChessMechanics::_seePackage ChessMechanics::_prepareForSEE(const int msbPos) const
+ChessMechanics::_seePackage ChessMechanics::_prepareForSEE(const int msbPos, const uint64_t fullMap) const
 {
     const uint64_t bishops = _board.BitBoards[wQueensIndex] | _board.BitBoards[bQueensIndex] |
                              _board.BitBoards[wBishopsIndex] | _board.BitBoards[bBishopsIndex];
     const uint64_t rooks = _board.BitBoards[wQueensIndex] | _board.BitBoards[bQueensIndex] |
                            _board.BitBoards[wRooksIndex] | _board.BitBoards[bRooksIndex];
     const uint64_t knights = _board.BitBoards[wKnightsIndex] | _board.BitBoards[bKnightsIndex];
-    const uint64_t kings   = _board.BitBoards[wKingIndex] | _board.BitBoards[bKnightsIndex];
-    const uint64_t fullMap =
-        bishops | rooks | knights | kings | _board.BitBoards[wPawnsIndex] | _board.BitBoards[bPawnsIndex];
+    const uint64_t kings   = _board.BitBoards[wKingIndex] | _board.BitBoards[bKingIndex];
 
     uint64_t attackers = 0;
     attackers |= (BishopMap::GetMoves(msbPos, fullMap) & bishops) | (RookMap::GetMoves(msbPos, fullMap) & rooks) |
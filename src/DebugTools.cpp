@@ -4,7 +4,6 @@
 
 #include "../include/TestsAndDebugging/DebugTools.h"
 #include "../include/MoveGeneration/MoveGenerator.h"
-#include "../include/Search/ZobristHash.h"
 
 bool IsDrawDebug(const Board &bd)
 {
@@ -14,9 +13,8 @@ bool IsDrawDebug(const Board &bd)
     auto mvs         = generator.GetMovesFast();
     const size_t cnt = mvs.size;
     s.PopAggregate(mvs);
-    const uint64_t hash = ZHasher.GenerateHash(bd);
 
-    return generator.IsDrawByReps(hash) || (cnt == 0 && !generator.IsCheck());
+    return generator.IsDrawByReps() || (cnt == 0 && !generator.IsCheck());
 }
 
 Move GetMoveDebug(const Board &bd, const std::string &str)
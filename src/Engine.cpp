@@ -7,7 +7,6 @@
 #include "../include/MoveGeneration/MoveGenerator.h"
 #include "../include/Search/BestMoveSearch.h"
 #include "../include/Search/TranspositionTable.h"
-#include "../include/Search/ZobristHash.h"
 #include "../include/ThreadManagement/GameTimeManager.h"
 
 std::string Engine::_debugEnginePath = Engine::_defaultBookPath;
@@ -16,8 +15,11 @@ void Engine::WriteBoard() const { DisplayBoard(_board); }
 
 std::map<std::string, uint64_t> Engine::GetPerft(const int depth)
 {
-    MoveGenerator mgen{_board, TManager.GetDefaultStack()};
-    return mgen.GetCountedMoves(depth);
+    // search threads are idle during perft, so their stacks are reused by the perft workers
+    std::vector<MoveGenerator::stck *> stacks{};
+    for (lli i = 0; i < _threadCount; ++i) stacks.push_back(&TManager.GetThreadStack(static_cast<size_t>(i)));
+
+    return MoveGenerator::GetCountedMoves(_board, depth, stacks, _perftTable.IsEnabled() ? &_perftTable : nullptr);
 }
 
 bool Engine::SetFenPosition(const std::string &fenStr)
@@ -55,10 +57,9 @@ const EngineInfo &Engine::GetEngineInfo() { return engineInfo; }
 bool Engine::ApplyMoves(const std::vector<std::string> &UCIMoves)
 {
     Board workBoard = _startingBoard;
-    uint64_t hash   = ZHasher.GenerateHash(workBoard);
 
     for (auto &move : UCIMoves)
-        if (!_applyMove(workBoard, move, hash))
+        if (!_applyMove(workBoard, move))
             return false;
     _board = workBoard;
 
@@ -69,33 +70,52 @@ bool Engine::ApplyMoves(const std::vector<std::string> &UCIMoves)
 
 void Engine::RestartEngine()
 {
+    // the table is cleared below, which must not happen under the running search
+    if (TManager.IsSearchOn())
+    {
+        GlobalLogger.LogStream << "[ ERROR ] not able to start new game while the search is running\n";
+        return;
+    }
+
     SetStartPos();
 
     GameTimeManager::Restart();
 
-    // cleaning tt
-    TTable.ClearTable();
+    // cleaning tt in the background, readiness is awaited on isready or next search
+    TTable.ClearTableAsync();
 }
 
 Board Engine::GetUnderlyingBoardCopy() const { return _board; }
 
 std::string Engine::GetFenTranslation() const { return FenTranslator::Translate(_board); }
 
-bool Engine::_applyMove(Board &board, const std::string &move, uint64_t &hash)
+bool Engine::_applyMove(Board &board, const std::string &move)
 {
+    static constexpr size_t MinMoveLength = 4;
+
+    if (move.length() < MinMoveLength)
+        return false;
+
+    const uint64_t startField = ExtractPosFromStr(move[0], move[1]);
+    if (startField == 0)
+        return false;
+
     MoveGenerator mech(board, TManager.GetDefaultStack());
 
-    // generating moves
-    auto moves = mech.GetMovesFast<false, false>();
+    // generating only moves of the figure standing on the start field
+    auto moves = mech.GetFigureMovesFast<false>(ExtractMsbPos(startField));
 
     for (size_t i = 0; i < moves.size; ++i)
         if (move == moves[i].GetLongAlgebraicNotation())
         {
-            VolatileBoardData data{board};
-            hash = ZHasher.UpdateHash(hash, moves[i], data);
-            board.Repetitions[hash]++;
-
             Move::MakeMove(moves[i], board);
+
+            // positions before irreversible move can not repeat anymore
+            if (board.HalfMoves == 0)
+                board.ResetRepetitionKeys(board.ZobristKey);
+            else
+                board.PushRepetitionKey(board.ZobristKey);
+
             TManager.GetDefaultStack().PopAggregate(moves);
             return true;
         }
@@ -121,10 +141,31 @@ void Engine::_changeOrSetLogFile([[maybe_unused]] Engine &eng, std::string &nPat
     }
 }
 
-void Engine::_changeHashSize([[maybe_unused]] Engine &eng, const lli size)
+void Engine::_changeHashSize(Engine &eng, const lli size)
 {
-    if (TTable.ResizeTable(size) == -1)
-        GlobalLogger.LogStream << std::format("[ ERROR ] not able to resize the table with passed size {} MB\n", size);
+    // the table is reallocated, which must not happen under the running search
+    if (eng.TManager.IsSearchOn())
+    {
+        GlobalLogger.LogStream << std::format(
+            "[ ERROR ] not able to resize the table to {} MB while the search is running\n", size
+        );
+        return;
+    }
+
+    TTable.ResizeTableAsync(size);
+}
+
+void Engine::_changeThreadCount(Engine &eng, const lli tCount)
+{
+    if (!eng.TManager.SetThreadCount(static_cast<size_t>(tCount)))
+    {
+        GlobalLogger.LogStream << std::format(
+            "[ ERROR ] not able to change thread count to {} while the search is running\n", tCount
+        );
+        return;
+    }
+
+    eng._threadCount = tCount;
 }
 
 void Engine::_changeBookUsage(Engine &eng, const bool newValue)
@@ -171,10 +212,56 @@ void Engine::StopSearch() { TManager.Stop(); }
 
 void Engine::GoInfinite() { TManager.GoInfinite(_board); }
 
-void Engine::_clearHash(Engine &) { TTable.ClearTable(); }
+void Engine::_clearHash(Engine &eng)
+{
+    if (eng.TManager.IsSearchOn())
+    {
+        GlobalLogger.LogStream << "[ ERROR ] not able to clear the hash while the search is running\n";
+        return;
+    }
+
+    TTable.ClearTableAsync();
+}
+
+void Engine::WaitForBackgroundTasks() { TTable.WaitForReady(); }
 
 void Engine::_changeDebugEnginePath(Engine &, std::string &path) { _debugEnginePath = path; }
 void Engine::_changeBookPath(Engine &engine, std::string &path) { engine._bookPath = path; }
+void Engine::_changeHashFilePath(Engine &eng, std::string &path) { eng._hashFilePath = path; }
+
+void Engine::_saveHashToFile(Engine &eng)
+{
+    if (!TTable.SaveToFile(eng._hashFilePath))
+        GlobalLogger.LogStream << std::format("[ ERROR ] not able to save the hash to file: {}\n", eng._hashFilePath);
+}
+
+void Engine::_loadHashFromFile(Engine &eng)
+{
+    // loading replaces the whole table, which is probed by the running search
+    if (eng.TManager.IsSearchOn())
+    {
+        GlobalLogger.LogStream << "[ ERROR ] not able to load the hash from file while the search is running\n";
+        return;
+    }
+
+    if (!TTable.LoadFromFile(eng._hashFilePath))
+        GlobalLogger.LogStream << std::format("[ ERROR ] not able to load the hash from file: {}\n", eng._hashFilePath);
+}
+
+void Engine::_changeTTStatistics([[maybe_unused]] Engine &eng, const bool enabled)
+{
+    TTable.SetStatisticsEnabled(enabled);
+}
+
+void Engine::_changePerftHashSize(Engine &eng, const lli size) { eng._perftTable.Resize(static_cast<size_t>(size)); }
+
+void Engine::_changeEvalCacheSize(Engine &eng, const lli size)
+{
+    if (!eng.TManager.SetEvalCacheSize(static_cast<size_t>(size)))
+        GlobalLogger.LogStream << std::format(
+            "[ ERROR ] not able to change eval cache size to {} while the search is running\n", size
+        );
+}
 
 void Engine::PonderHit()
 {
@@ -189,7 +276,8 @@ void Engine::PonderHit()
 
 int Engine::GetQuiesceEval()
 {
-    BestMoveSearch searcher{_board, TManager.GetDefaultStack()};
+    TTable.WaitForReady();
+    BestMoveSearch searcher{_board, TManager.GetDefaultStack(), 0, nullptr, 1, &TManager.GetDefaultEvalTables()};
     return searcher.QuiesceEval() * SCORE_GRAIN;
 }
 
@@ -7,6 +7,11 @@
 #include <cstring>
 #include <format>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include "../include/Interface/Logger.h"
 
 const char IndexToFigCharMap[Board::BitBoardsCount]{
@@ -153,6 +158,105 @@ void AlignedFree(void *ptr)
 #endif
 }
 
+LargePageAllocation LargePageAlloc(const size_t size)
+{
+#ifdef __linux__
+    static constexpr size_t HugePageSize2MB = 2 * MB;
+    static constexpr size_t HugePageSize1GB = 1024 * MB;
+
+    const auto roundUp = [](const size_t value, const size_t align)
+    {
+        return (value + align - 1) / align * align;
+    };
+
+    // Explicit huge pages available only when the pool was reserved by the system administrator
+    for (const auto [pageSize, pageFlag] : {std::pair{HugePageSize1GB, 30}, std::pair{HugePageSize2MB, 21}})
+    {
+        // avoid wasting the pool on small allocations
+        if (size < pageSize)
+            continue;
+
+        const size_t allocSize = roundUp(size, pageSize);
+        void *ptr              = mmap(
+            nullptr, allocSize, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (pageFlag << MAP_HUGE_SHIFT), -1, 0
+        );
+
+        if (ptr != MAP_FAILED)
+            return {ptr, allocSize, pageSize, false};
+    }
+
+    // Fall back to transparent huge pages
+    const size_t allocSize = roundUp(size, HugePageSize2MB);
+    void *ptr              = mmap(nullptr, allocSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (ptr == MAP_FAILED)
+        return {};
+
+    if (madvise(ptr, allocSize, MADV_HUGEPAGE) == 0)
+        return {ptr, allocSize, HugePageSize2MB, true};
+
+    return {ptr, allocSize, static_cast<size_t>(sysconf(_SC_PAGESIZE)), false};
+#else
+    static constexpr size_t DefaultAlignment = 64;
+    static constexpr size_t DefaultPageSize  = 4096;
+
+    void *ptr = AlignedAlloc(DefaultAlignment, size);
+    return {ptr, ptr == nullptr ? 0 : size, DefaultPageSize, false};
+#endif
+}
+
+void LargePageFree(const LargePageAllocation &allocation)
+{
+    if (allocation.ptr == nullptr)
+        return;
+
+#ifdef __linux__
+    munmap(allocation.ptr, allocation.size);
+#else
+    AlignedFree(allocation.ptr);
+#endif
+}
+
+void *LazyCommitAlloc(const size_t size)
+{
+#ifdef __linux__
+    // no MAP_POPULATE, so pages are faulted in only when the buffer grows into them
+    void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+#else
+    static constexpr size_t DefaultAlignment = 64;
+
+    return AlignedAlloc(DefaultAlignment, size);
+#endif
+}
+
+void LazyCommitFree(void *ptr, [[maybe_unused]] const size_t size)
+{
+    if (ptr == nullptr)
+        return;
+
+#ifdef __linux__
+    munmap(ptr, size);
+#else
+    AlignedFree(ptr);
+#endif
+}
+
+std::string GetPageSizeStr(const LargePageAllocation &allocation)
+{
+    const size_t pageSize = allocation.pageSize;
+    const std::string sizeStr =
+        pageSize >= MB * 1024 ? std::format("{}GB", pageSize / (MB * 1024))
+        : pageSize >= MB      ? std::format("{}MB", pageSize / MB)
+                              : std::format("{}KB", pageSize / 1024);
+
+    if (pageSize < MB)
+        return sizeStr;
+
+    return sizeStr + (allocation.isTransparent ? " transparent huge" : " huge");
+}
+
 std::string GetCurrentTimeStr()
 {
     static constexpr size_t BuffSize = 128;
@@ -4,6 +4,7 @@
 
 #include "../include/Interface/FenTranslator.h"
 
+#include "../include/Evaluation/PieceSquareTables.h"
 #include "../include/Interface/Logger.h"
 #include "../include/MoveGeneration/BlackPawnMap.h"
 #include "../include/MoveGeneration/WhitePawnMap.h"
@@ -34,8 +35,9 @@ bool FenTranslator::Translate(const std::string &fenPos, Board &bd)
         // We store half moves instead of full moves
         workBoard.Age = std::max(static_cast<uint16_t>(age * 2 - 1), static_cast<uint16_t>(1));
 
-        const uint64_t startHash = ZHasher.GenerateHash(workBoard);
-        workBoard.Repetitions[startHash]++;
+        ZHasher.RecomputeHashes(workBoard);
+        PieceSquareTables::Recompute(workBoard);
+        workBoard.ResetRepetitionKeys(workBoard.ZobristKey);
     }
     catch (const std::exception &exc)
     {
@@ -319,6 +321,7 @@ void FenTranslator::_addFigure(const std::string &pos, char fig, Board &bd)
         );
 
     bd.BitBoards[FigCharToIndexMap.at(fig)] |= field;
+    bd.PieceOnSquare[ExtractMsbPos(field)] = static_cast<uint8_t>(FigCharToIndexMap.at(fig));
 }
 
 size_t FenTranslator::_skipBlanks(size_t pos, const std::string &fenPos)
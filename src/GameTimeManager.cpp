@@ -16,12 +16,23 @@ double GameTimeManager::expectedMoves  = averageMovesPerGame * distribution;
 double GameTimeManager::moveCorrection = averageMovesPerGame * (1 - distribution);
 
 bool GameTimeManager::TimerRunning       = false;
-bool GameTimeManager::ShouldStop         = false;
+std::atomic<bool> GameTimeManager::ShouldStop = false;
+bool GameTimeManager::_isDeadlineActive       = false;
+bool GameTimeManager::_shouldTimerExit        = false;
+std::atomic<lli> GameTimeManager::_searchDeadlineNs = NoDeadline;
 GoTimeInfo GameTimeManager::_ponderTimes = {};
 std::chrono::time_point<std::chrono::system_clock> GameTimeManager::TimeStart;
-std::chrono::time_point<std::chrono::system_clock> GameTimeManager::CurrentTime;
+std::chrono::time_point<std::chrono::steady_clock> GameTimeManager::_deadline;
 std::mutex GameTimeManager::mtx;
 std::condition_variable GameTimeManager::cv;
+std::thread GameTimeManager::_timerThread;
+
+// Static objects are destroyed in reverse order of their construction, so the timer thread is joined before the mutex
+// and the condition variable defined above are destroyed
+static const struct TimerThreadJoiner
+{
+    ~TimerThreadJoiner() { GameTimeManager::StopTimer(); }
+} TimerJoiner{};
 
 void GameTimeManager::StartTimerAsync()
 {
@@ -30,27 +41,62 @@ void GameTimeManager::StartTimerAsync()
 
     TimerRunning = true;
     TimeStart    = std::chrono::system_clock::now();
-    CurrentTime  = TimeStart;
-    std::thread timerThread(_timer_thread);
-    timerThread.detach(); // detach the thread to avoid memory leak
+    _timerThread = std::thread(_timer_thread);
+}
+
+void GameTimeManager::StopTimer()
+{
+    if (!TimerRunning)
+        return;
+
+    {
+        std::lock_guard lock(mtx);
+        _shouldTimerExit = true;
+    }
+    cv.notify_one();
+
+    _timerThread.join();
+    TimerRunning     = false;
+    _shouldTimerExit = false;
 }
 
 void GameTimeManager::_timer_thread()
 {
+    std::unique_lock lock(mtx);
+
     while (true)
     {
-        {
-            std::lock_guard<std::mutex> lock(mtx);
-            CurrentTime = std::chrono::system_clock::now();
-        }
-        cv.notify_all();
-        std::this_thread::sleep_for(std::chrono::milliseconds(resolutionMs));
+        // sleep until some search sets up the deadline or the program exits
+        cv.wait(lock, [] { return _isDeadlineActive || _shouldTimerExit; });
+
+        if (_shouldTimerExit)
+            return;
+
+        // sleep until the deadline passes, unless it is changed or cancelled in the meantime
+        const auto deadline = _deadline;
+        if (cv.wait_until(lock, deadline, [&] {
+                return !_isDeadlineActive || _deadline != deadline || _shouldTimerExit;
+            }))
+            continue;
+
+        ShouldStop.store(true, std::memory_order_relaxed);
+        _isDeadlineActive = false;
     }
 }
 
-[[maybe_unused]] std::chrono::time_point<std::chrono::system_clock> GameTimeManager::ForceUpdateCurrentTime()
+void GameTimeManager::_setDeadline(const std::chrono::time_point<std::chrono::steady_clock> deadline)
 {
-    return CurrentTime = std::chrono::system_clock::now();
+    _searchDeadlineNs.store(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count(),
+        std::memory_order_relaxed
+    );
+
+    {
+        std::lock_guard lock(mtx);
+        _deadline         = deadline;
+        _isDeadlineActive = true;
+    }
+    cv.notify_one();
 }
 
 void GameTimeManager::StartSearchManagementAsync(
@@ -60,16 +106,18 @@ void GameTimeManager::StartSearchManagementAsync(
     assert(TimerRunning && "Timer must be running"); // Timer must be running
 
     // Set the beginning of the move to the current time
-    auto moveStartTimeMs = CurrentTime;
+    const auto moveStartTime = std::chrono::steady_clock::now();
 
-    ShouldStop = false;
+    ShouldStop.store(false, std::memory_order_relaxed);
 
     auto [timeLimitClockMs, timeLimitPerMoveMs, incrementMs] = GameTimeManagerUtils::ParseGoTimeInfo(tInfo, color);
 
     // If both time limits are not set, then there is no time limit
     if (timeLimitClockMs == GoTimeInfo::Infinite && timeLimitPerMoveMs == GoTimeInfo::Infinite)
     {
-        // No time limit
+        // No time limit, drop the deadline possibly left by the previous search
+        _searchDeadlineNs.store(NoDeadline, std::memory_order_relaxed);
+        _cancelDeadline();
         return;
     }
 
@@ -79,34 +127,33 @@ void GameTimeManager::StartSearchManagementAsync(
         timeForMoveMs = CalculateTimeMsPerMove(bd, timeLimitClockMs, timeLimitPerMoveMs, incrementMs, moveAge, color);
     }
 
-    // const lli timeForMoveMs = 0;
+    // pass the time limit to the timer thread
+    _setDeadline(moveStartTime + std::chrono::milliseconds(timeForMoveMs));
+}
 
-    // time limit
-    std::thread searchManagementThread(_search_management_thread, moveStartTimeMs, timeForMoveMs);
-    searchManagementThread.detach();
+void GameTimeManager::_cancelDeadline()
+{
+    {
+        std::lock_guard lock(mtx);
+        _isDeadlineActive = false;
+    }
+    cv.notify_one();
 }
 
-void GameTimeManager::StopSearchManagement() { ShouldStop = true; }
+void GameTimeManager::StopSearchManagement()
+{
+    // deadline of the searchers is kept to allow measuring the overshoot
+    ShouldStop.store(true, std::memory_order_relaxed);
+    _cancelDeadline();
+}
 
-void GameTimeManager::_search_management_thread(
-    const std::chrono::time_point<std::chrono::system_clock> moveStartTimeMs, const lli timeForMoveMs
-)
+lli GameTimeManager::GetDeadlineOvershootUs()
 {
-    const auto moveStopTimeMs = moveStartTimeMs + std::chrono::milliseconds(timeForMoveMs);
+    const lli deadline = _searchDeadlineNs.load(std::memory_order_relaxed);
+    if (deadline == NoDeadline)
+        return -1;
 
-    while (!ShouldStop)
-    {
-        {
-            // Wait for update of the current time
-            std::unique_lock<std::mutex> lock(mtx);
-            cv.wait(lock);
-        }
-
-        if (CurrentTime >= moveStopTimeMs)
-        {
-            ShouldStop = true;
-        }
-    }
+    return (_getSteadyNs() - deadline) / 1000;
 }
 
 lli GameTimeManager::CalculateTimeMsPerMove(
@@ -281,7 +328,9 @@ lli GameTimeManager::CalculateTimeMsPerMove(
 void GameTimeManager::StartPonder(const GoTimeInfo &tInfo)
 {
     _ponderTimes = tInfo;
-    ShouldStop   = false;
+    _searchDeadlineNs.store(NoDeadline, std::memory_order_relaxed);
+    _cancelDeadline();
+    ShouldStop.store(false, std::memory_order_relaxed);
 }
 
 void GameTimeManager::PonderHit(Color color, const Board &bd)
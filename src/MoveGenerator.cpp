@@ -4,53 +4,138 @@
 
 #include "../include/MoveGeneration/MoveGenerator.h"
 
-std::map<std::string, uint64_t> MoveGenerator::GetCountedMoves(const int depth)
+#include <atomic>
+#include <thread>
+
+std::map<std::string, uint64_t> MoveGenerator::GetCountedMoves(
+    const Board &bd, const int depth, const std::vector<stck *> &stacks, PerftTable *table
+)
 {
     TraceIfFalse(depth >= 1, "Depth must be at least 1!");
+    TraceIfFalse(!stacks.empty(), "At least one stack must be passed!");
 
-    std::map<std::string, uint64_t> rv{};
-    Board workBoard = _board;
+    // generate root moves once, they are shared by all workers
+    MoveGenerator rootGen{bd, *stacks[0]};
+    const auto moves = rootGen.GetMovesFast<false, false>();
+    const std::vector<Move> rootMoves(moves.data, moves.data + moves.size);
+    stacks[0]->PopAggregate(moves);
 
-    VolatileBoardData data{_board};
+    const VolatileBoardData data{bd};
 
-    auto moves = GetMovesFast<false, false>();
-    for (size_t i = 0; i < moves.size; ++i)
+    std::vector<uint64_t> counts(rootMoves.size());
+    std::atomic<size_t> nextMove{};
+
+    // every worker takes next unprocessed root move until all are counted
+    const auto worker = [&](stck &s)
     {
-        Move::MakeMove(moves[i], workBoard);
-        const uint64_t moveCount = CountMoves(workBoard, depth - 1);
-        Move::UnmakeMove(moves[i], workBoard, data);
+        Board workBoard = bd;
+        MoveGenerator gen{workBoard, s};
 
-        rv.emplace(moves[i].GetLongAlgebraicNotation(), moveCount);
-    }
+        for (size_t i = nextMove.fetch_add(1); i < rootMoves.size(); i = nextMove.fetch_add(1))
+        {
+            Move::MakeMove(rootMoves[i], workBoard);
+            counts[i] = table != nullptr ? gen._countMoves<true>(workBoard, depth - 1, table)
+                                         : gen._countMoves<false>(workBoard, depth - 1, nullptr);
+            Move::UnmakeMove(rootMoves[i], workBoard, data);
+        }
+    };
+
+    const size_t threadCount = std::min(stacks.size(), rootMoves.size());
+    std::vector<std::thread> threads{};
+    for (size_t i = 1; i < threadCount; ++i) threads.emplace_back(worker, std::ref(*stacks[i]));
+
+    worker(*stacks[0]);
+    for (auto &thread : threads) thread.join();
+
+    std::map<std::string, uint64_t> rv{};
+    for (size_t i = 0; i < rootMoves.size(); ++i) rv.emplace(rootMoves[i].GetLongAlgebraicNotation(), counts[i]);
 
-    _threadStack.PopAggregate(moves);
     return rv;
 }
 
-uint64_t MoveGenerator::CountMoves(Board &bd, const int depth)
+uint64_t MoveGenerator::_getDiscoveringFigures(const int enemyKingMsbPos, const uint64_t fullMap) const
+{
+    const size_t allyCord  = _board.MovingColor * Board::BitBoardsPerCol;
+    const uint64_t allyMap = _info.ColorMaps[_board.MovingColor];
+    const uint64_t rooks   = _board.BitBoards[allyCord + rooksIndex] | _board.BitBoards[allyCord + queensIndex];
+    const uint64_t bishops = _board.BitBoards[allyCord + bishopsIndex] | _board.BitBoards[allyCord + queensIndex];
+
+    const uint64_t rookLines   = RookMap::GetMoves(enemyKingMsbPos, fullMap);
+    const uint64_t bishopLines = BishopMap::GetMoves(enemyKingMsbPos, fullMap);
+
+    // sliding figures attacking the king when the first own figures on the lines are removed
+    uint64_t rookXrays   = RookMap::GetMoves(enemyKingMsbPos, fullMap ^ (rookLines & allyMap)) & rooks;
+    uint64_t bishopXrays = BishopMap::GetMoves(enemyKingMsbPos, fullMap ^ (bishopLines & allyMap)) & bishops;
+
+    // the blocking figure lies on lines of both the king and the slider
+    uint64_t figures{};
+    for (; rookXrays; rookXrays ^= ExtractLsbBit(rookXrays))
+        figures |= RookMap::GetMoves(ExtractMsbPos(ExtractLsbBit(rookXrays)), fullMap) & rookLines & allyMap;
+
+    for (; bishopXrays; bishopXrays ^= ExtractLsbBit(bishopXrays))
+        figures |= BishopMap::GetMoves(ExtractMsbPos(ExtractLsbBit(bishopXrays)), fullMap) & bishopLines & allyMap;
+
+    return figures;
+}
+
+const std::array<uint64_t, Board::BitBoardsPerCol> &MoveGenerator::_getCheckFields()
+{
+    static constexpr uint64_t KingChecks = 0;
+
+    if (_areCheckFieldsReady)
+        return _checkFields;
+
+    const int enemyKingPos      = _board.GetKingMsbPos(SwapColor(_board.MovingColor));
+    const uint64_t enemyKing    = MaxMsbPossible >> enemyKingPos;
+    const uint64_t fullMap      = _info.FullMap;
+    const uint64_t bishopChecks = BishopMap::GetMoves(enemyKingPos, fullMap);
+    const uint64_t rookChecks   = RookMap::GetMoves(enemyKingPos, fullMap);
+    const uint64_t pawnChecks   = _board.MovingColor == WHITE ? BlackPawnMap::GetAttackFields(enemyKing)
+                                                              : WhitePawnMap::GetAttackFields(enemyKing);
+
+    // sliding figures attack the king from the same fields the king would attack them from
+    _checkFields = {
+        pawnChecks, KnightMap::GetMoves(enemyKingPos), bishopChecks, rookChecks, bishopChecks | rookChecks, KingChecks
+    };
+    _areCheckFieldsReady = true;
+
+    return _checkFields;
+}
+
+uint64_t MoveGenerator::CountMoves(Board &bd, const int depth) { return _countMoves<false>(bd, depth, nullptr); }
+
+template <bool UseTable> uint64_t MoveGenerator::_countMoves(Board &bd, const int depth, PerftTable *table)
 {
     if (depth == 0)
         return 1;
 
+    uint64_t sum{};
+    if constexpr (UseTable)
+        if (depth > 1 && table->Probe(bd.ZobristKey, depth, sum))
+            return sum;
+
     MoveGenerator mgen{bd, _threadStack};
     const auto moves = mgen.GetMovesFast<false, false>();
 
+    // bulk counting - leaves are not visited at all
     if (depth == 1)
     {
         _threadStack.PopAggregate(moves);
         return moves.size;
     }
 
-    uint64_t sum{};
-
-    VolatileBoardData data{_board};
+    VolatileBoardData data{bd};
     for (size_t i = 0; i < moves.size; ++i)
     {
         Move::MakeMove(moves[i], bd);
-        sum += CountMoves(bd, depth - 1);
+        sum += _countMoves<UseTable>(bd, depth - 1, table);
         Move::UnmakeMove(moves[i], bd, data);
     }
 
     _threadStack.PopAggregate(moves);
+
+    if constexpr (UseTable)
+        table->Store(bd.ZobristKey, depth, sum);
+
     return sum;
 }
@@ -14,7 +14,8 @@
 #include "../include/TestsAndDebugging/CsvOperator.h"
 
 bool SearchPerfTester::PerformSearchPerfTest(
-    const std::string &inputTestPath, const std::string &output, Stack<Move, DEFAULT_STACK_SIZE> &stack
+    const std::string &inputTestPath, const std::string &output, Stack<Move, DEFAULT_STACK_SIZE> &stack,
+    BestMoveSearch::EvalTables &evalTables
 )
 {
     // reading csv file
@@ -27,7 +28,7 @@ bool SearchPerfTester::PerformSearchPerfTest(
 
     for (const auto &[testCase, dep] : tests)
     {
-        const double result = _performTestCase(testCase, dep, stack);
+        const double result = _performTestCase(testCase, dep, stack, evalTables);
         sumTime += result;
 
         results.emplace_back(testCase, dep, result);
@@ -45,12 +46,14 @@ bool SearchPerfTester::PerformSearchPerfTest(
     return true;
 }
 
-double
-SearchPerfTester::_performTestCase(const std::string &testCase, const int depth, Stack<Move, DEFAULT_STACK_SIZE> &stack)
+double SearchPerfTester::_performTestCase(
+    const std::string &testCase, const int depth, Stack<Move, DEFAULT_STACK_SIZE> &stack,
+    BestMoveSearch::EvalTables &evalTables
+)
 {
     Board bd;
     FenTranslator::Translate(testCase, bd);
-    BestMoveSearch searcher(bd, stack);
+    BestMoveSearch searcher(bd, stack, 0, nullptr, 1, &evalTables);
 
     const auto tStart = std::chrono::steady_clock::now();
     if (depth > 0)
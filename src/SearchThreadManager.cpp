@@ -4,6 +4,7 @@
 
 #include "../include/ThreadManagement/SearchThreadManager.h"
 #include "../include/Search/BestMoveSearch.h"
+#include "../include/Search/TranspositionTable.h"
 #include "../include/ThreadManagement/GameTimeManager.h"
 
 #include <format>
@@ -13,14 +14,10 @@ SearchThreadManager::~SearchThreadManager()
     // cancel search if is up
     Stop();
 
-    // signal stop
-    _shouldStop = true;
-    _searchSem.release();
-
-    _threads[MainSearchThreadInd]->join();
-    delete _threads[MainSearchThreadInd];
-    _threads[MainSearchThreadInd] = nullptr;
+    // signal stop to every running thread
+    for (size_t i = 0; i < _threadCount; ++i) _stopThread(i);
 }
+
 bool SearchThreadManager::Go(const Board &bd, const GoInfo &info)
 {
     // ensuring only one search is running at a time
@@ -29,6 +26,9 @@ bool SearchThreadManager::Go(const Board &bd, const GoInfo &info)
 
     _isPonderOn = info.isPonderSearch;
 
+    // table cannot be probed while it is being rebuilt
+    TTable.WaitForReady();
+
     // Setting up time guarding parameters
     if (!info.isPonderSearch)
         GameTimeManager::StartSearchManagementAsync(info.timeInfo, static_cast<Color>(bd.MovingColor), bd, bd.Age);
@@ -42,7 +42,7 @@ bool SearchThreadManager::Go(const Board &bd, const GoInfo &info)
     _searchArgs.depth = info.depth;
 
     // signal search start
-    _searchSem.release();
+    _workers[MainSearchThreadInd].taskSem.release();
 
     // wait for search thread start to prevent races on guard
     _bootupSem.acquire();
@@ -69,68 +69,208 @@ void SearchThreadManager::Stop() const
     GameTimeManager::StopSearchManagement();
 }
 
+bool SearchThreadManager::SetThreadCount(const size_t threadCount)
+{
+    TraceIfFalse(threadCount >= 1 && threadCount <= MaxSearchThreads, "Invalid thread count!");
+
+    // threads cannot be changed when they are working
+    if (_isSearchOn || threadCount < 1 || threadCount > MaxSearchThreads)
+        return false;
+
+    // start missing helpers
+    for (size_t i = _threadCount; i < threadCount; ++i) _startThread(i);
+
+    // stop unnecessary helpers
+    for (size_t i = threadCount; i < _threadCount; ++i) _stopThread(i);
+
+    _threadCount = threadCount;
+    return true;
+}
+
+bool SearchThreadManager::SetEvalCacheSize(const size_t sizeMB)
+{
+    // caches are used by the running search
+    if (_isSearchOn)
+        return false;
+
+    _evalCacheSizeMB = sizeMB;
+    for (size_t i = 0; i < _threadCount; ++i) _evalTables[i]->Cache.Resize(sizeMB);
+
+    return true;
+}
+
 void SearchThreadManager::GoWoutThread(const Board &bd, const GoInfo &info)
 {
     static StackType s{};
+    static BestMoveSearch::EvalTables evalTables{EVAL_CACHE_DEFAULT_SIZE_MB};
+
+    TTable.WaitForReady();
 
     GameTimeManager::StartSearchManagementAsync(info.timeInfo, static_cast<Color>(bd.MovingColor), bd, bd.Age);
 
     PackedMove output{};
     PackedMove ponder{};
 
-    BestMoveSearch searcher{bd, s};
+    TTable.IncrementGeneration();
+
+    BestMoveSearch searcher{bd, s, 0, nullptr, 1, &evalTables};
     searcher.IterativeDeepening(&output, &ponder, info.depth);
 
+    if (TTable.IsStatisticsEnabled())
+        TTable.DisplayStatisticsAndReset();
+
+    _reportOvershoot();
+
     GlobalLogger.LogStream << std::format("bestmove {}", output.GetLongAlgebraicNotation())
                            << (ponder.IsEmpty() ? "" : std::format(" ponder {}", ponder.GetLongAlgebraicNotation()))
                            << std::endl;
 }
 
-void SearchThreadManager::_passiveThreadSearchJob(
-    Stack<Move, DEFAULT_STACK_SIZE> *s, SearchThreadManager::_searchArgs_t *args, bool *guard, const bool *shouldStop,
-    std::binary_semaphore *taskSem, std::binary_semaphore *bootup
-)
+void SearchThreadManager::_passiveThreadSearchJob(SearchThreadManager *manager, const size_t threadInd)
 {
-    PackedMove output{};
-    PackedMove ponder{};
+    _worker_t &worker = manager->_workers[threadInd];
 
-    // be alive until SearchThreadManager is destructed
-    while (!*shouldStop)
+    // be alive until SearchThreadManager is destructed or thread is disabled
+    while (!worker.shouldStop)
     {
         // waiting for task
-        taskSem->acquire();
+        worker.taskSem.acquire();
 
         // destruction is being processed
-        if (*shouldStop)
+        if (worker.shouldStop)
         {
             break;
         }
 
-        // Read arguments
-        const Board &bd = *(args->bd);
-        const int depth = args->depth;
+        if (threadInd == MainSearchThreadInd)
+            manager->_mainThreadSearch(manager->_searchArgs);
+        else
+            manager->_helperThreadSearch(threadInd);
+    }
+}
 
-        // harden search status
-        *guard = true;
-        // signal start command that thread is ready
-        bootup->release();
+void SearchThreadManager::_mainThreadSearch(const _searchArgs_t &args)
+{
+    // Read arguments, board is copied to be safely shared with the helpers
+    const Board bd    = *(args.bd);
+    const int depth   = args.depth;
+    const size_t tCnt = _threadCount;
 
-        // run search
-        BestMoveSearch searcher{bd, *s};
-        searcher.IterativeDeepening(&output, &ponder, depth);
+    // harden search status
+    _isSearchOn = true;
+    // signal start command that thread is ready
+    _bootupSem.release();
 
-        GlobalLogger.LogStream << std::format("bestmove {}", output.GetLongAlgebraicNotation())
-                               << (ponder.IsEmpty() ? "" : std::format(" ponder {}", ponder.GetLongAlgebraicNotation()))
-                               << std::endl;
+    // age the entries of previous searches
+    TTable.IncrementGeneration();
 
-        // harden search status
-        *guard = false;
+    // prepare helpers
+    for (size_t i = 0; i < tCnt; ++i)
+    {
+        _nodeCounters[i].Nodes.store(0, std::memory_order_relaxed);
+        _results[i] = {};
     }
+    _helperArgs.bd    = &bd;
+    _helperArgs.depth = depth;
+
+    // wake up the helpers
+    for (size_t i = 1; i < tCnt; ++i) _workers[i].taskSem.release();
+
+    // run search
+    PackedMove output{};
+    PackedMove ponder{};
+    BestMoveSearch searcher{
+        bd, *_stacks[MainSearchThreadInd], MainSearchThreadInd, _nodeCounters, tCnt,
+        _evalTables[MainSearchThreadInd].get()
+    };
+    const int eval = searcher.IterativeDeepening(&output, &ponder, depth);
+    _results[MainSearchThreadInd] = {output, ponder, eval, searcher.GetCompletedDepth()};
+
+    // stop the helpers and wait for them to finish
+    if (tCnt > 1)
+    {
+        GameTimeManager::StopSearchManagement();
+        for (size_t i = 1; i < tCnt; ++i) _helpersFinishedSem.acquire();
+    }
+
+    if (TTable.IsStatisticsEnabled())
+        TTable.DisplayStatisticsAndReset();
+
+    _reportOvershoot();
+
+    const _threadResult_t &result = _selectBestResult(tCnt);
+    const std::string bestMoveInfo =
+        std::format("bestmove {}", result.bestMove.GetLongAlgebraicNotation()) +
+        (result.ponderMove.IsEmpty() ? "" : std::format(" ponder {}", result.ponderMove.GetLongAlgebraicNotation()));
+
+    // harden search status before reporting the move, GUI may send next commands right after receiving it
+    _isSearchOn = false;
+
+    GlobalLogger.LogStream << bestMoveInfo << std::endl;
+}
+
+void SearchThreadManager::_helperThreadSearch(const size_t threadInd)
+{
+    PackedMove output{};
+    PackedMove ponder{};
+
+    // run search silently
+    BestMoveSearch searcher{
+        *_helperArgs.bd, *_stacks[threadInd], threadInd, _nodeCounters, _threadCount, _evalTables[threadInd].get()
+    };
+    const int eval      = searcher.IterativeDeepening(&output, &ponder, _helperArgs.depth, false);
+    _results[threadInd] = {output, ponder, eval, searcher.GetCompletedDepth()};
+
+    // signal main thread that the work is done
+    _helpersFinishedSem.release();
+}
+
+const SearchThreadManager::_threadResult_t &SearchThreadManager::_selectBestResult(const size_t threadCount) const
+{
+    const _threadResult_t *best = &_results[MainSearchThreadInd];
+
+    // helper result is accepted only when it comes from deeper iteration and has better score
+    for (size_t i = 1; i < threadCount; ++i)
+        if (_results[i].depth > best->depth && _results[i].eval > best->eval && !_results[i].bestMove.IsEmpty())
+            best = &_results[i];
+
+    return *best;
 }
 
-SearchThreadManager::SearchThreadManager()
+void SearchThreadManager::_reportOvershoot()
 {
-    _threads[MainSearchThreadInd] = new std::thread(
-        _passiveThreadSearchJob, &GetDefaultStack(), &_searchArgs, &_isSearchOn, &_shouldStop, &_searchSem, &_bootupSem
-    );
+    // negative values mean the search finished before the deadline or had no deadline at all
+    if (const lli overshootUs = GameTimeManager::GetDeadlineOvershootUs(); overshootUs >= 0)
+        GlobalLogger.LogStream << std::format("info string time overshoot {} us", overshootUs) << std::endl;
 }
+
+void SearchThreadManager::_startThread(const size_t threadInd)
+{
+    TraceIfFalse(_workers[threadInd].thread == nullptr, "Thread is already running!");
+
+    _stacks[threadInd]     = std::make_unique<StackType>();
+    _evalTables[threadInd] = std::make_unique<BestMoveSearch::EvalTables>(_evalCacheSizeMB);
+    _workers[threadInd].shouldStop = false;
+    _workers[threadInd].thread     = new std::thread(_passiveThreadSearchJob, this, threadInd);
+}
+
+void SearchThreadManager::_stopThread(const size_t threadInd)
+{
+    _worker_t &worker = _workers[threadInd];
+
+    if (worker.thread == nullptr)
+        return;
+
+    // signal stop
+    worker.shouldStop = true;
+    worker.taskSem.release();
+
+    worker.thread->join();
+    delete worker.thread;
+    worker.thread = nullptr;
+
+    _stacks[threadInd].reset();
+    _evalTables[threadInd].reset();
+}
+
+SearchThreadManager::SearchThreadManager() { _startThread(MainSearchThreadInd); }
@@ -4,43 +4,252 @@
 
 #include "../include/Search/TranspositionTable.h"
 
+#include "../include/Search/ZobristHash.h"
+
+#include <algorithm>
 #include <bit>
 #include <cstring>
+#include <filesystem>
 #include <format>
+#include <fstream>
+#include <numeric>
 #include <stdexcept>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 TranspositionTable TTable{};
 
 TranspositionTable::TranspositionTable()
-    : _tableSize(StartTableSize), _hashMask(_getPow2ModuloMask(StartTableSize)),
-      _map{static_cast<HashRecord *>(AlignedAlloc(_entryAlignment, sizeof(HashRecord) * StartTableSize))}
 {
+    _allocate(StartTableSize);
     _checkForCorrectAlloc(StartTableSize);
     ClearTable();
 }
 
-TranspositionTable::~TranspositionTable() { AlignedFree(_map); }
+TranspositionTable::~TranspositionTable()
+{
+    WaitForReady();
+    LargePageFree(_allocation);
+}
 
 void TranspositionTable::ClearTable()
 {
-    memset(_map, 0, _tableSize * sizeof(HashRecord));
-    _containedRecords = 0;
+    WaitForReady();
+    _parallelClear();
+}
+
+void TranspositionTable::ClearTableAsync()
+{
+    WaitForReady();
+    _backgroundThread = std::thread([this] { _parallelClear(); });
+}
+
+void TranspositionTable::WaitForReady()
+{
+    if (_backgroundThread.joinable())
+        _backgroundThread.join();
 }
 
 signed_size_t TranspositionTable::ResizeTable(const size_t sizeMB)
 {
-    AlignedFree(_map);
+    WaitForReady();
+    const signed_size_t result = _reallocate(sizeMB);
+    ClearTable();
+
+    return result;
+}
+
+signed_size_t TranspositionTable::ResizeTableAsync(const size_t sizeMB)
+{
+    WaitForReady();
+
+    // unmapping the old table and mapping the new one may take long for big tables, so it is done in the background too
+    _backgroundThread = std::thread(
+        [this, sizeMB]
+        {
+            if (_reallocate(sizeMB) == -1)
+                GlobalLogger.LogStream << std::format(
+                    "[ ERROR ] not able to resize the table with passed size {} MB, using default size\n", sizeMB
+                );
+
+            _parallelClear();
+        }
+    );
+
+    return static_cast<signed_size_t>(std::bit_floor(sizeMB));
+}
+
+bool TranspositionTable::SaveToFile(const std::string &path)
+{
+    WaitForReady();
+
+    const std::string tmpPath = path + ".tmp";
+    std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+
+    if (!stream)
+    {
+        WrapTraceMsgError(std::format("Not able to open file: {} to save the TTable", tmpPath));
+        return false;
+    }
+
+    const _fileHeader_t header{
+        .magic            = _fileMagic,
+        .formatVersion    = _fileFormatVersion,
+        .bucketSize       = static_cast<uint32_t>(sizeof(_bucket_t)),
+        .entriesPerBucket = static_cast<uint32_t>(EntriesPerBucket),
+        .generation       = _generation,
+        .bucketCount      = _tableSize,
+        .hashSeed         = ZobristHasher::BaseSeed,
+    };
+
+    char headerBuff[_fileHeaderSize]{};
+    memcpy(headerBuff, &header, sizeof(header));
+
+    stream.write(headerBuff, _fileHeaderSize);
+    stream.write(reinterpret_cast<const char *>(_map), static_cast<std::streamsize>(_tableSize * sizeof(_bucket_t)));
+    stream.close();
+
+    std::error_code ec{};
+    if (!stream || (std::filesystem::rename(tmpPath, path, ec), ec))
+    {
+        WrapTraceMsgError(std::format("Not able to save the TTable to file: {}", path));
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    WrapTraceMsgInfo(std::format("TTable saved to file: {}", path));
+    return true;
+}
+
+bool TranspositionTable::LoadFromFile(const std::string &path)
+{
+    WaitForReady();
+
+    std::error_code ec{};
+    const size_t fileSize = std::filesystem::file_size(path, ec);
+
+    if (ec || fileSize < _fileHeaderSize)
+    {
+        WrapTraceMsgError(std::format("Not able to read TTable file: {}", path));
+        return false;
+    }
+
+    _fileHeader_t header{};
+    {
+        std::ifstream stream(path, std::ios::binary);
+        stream.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+        if (!stream || !_isFileHeaderValid(header, fileSize))
+        {
+            WrapTraceMsgError(std::format("File: {} does not contain compatible TTable", path));
+            return false;
+        }
+    }
+
+#ifdef __linux__
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        WrapTraceMsgError(std::format("Not able to open TTable file: {}", path));
+        return false;
+    }
+
+    // private mapping allows writing to the table without modifying the file
+    void *ptr = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (ptr == MAP_FAILED)
+    {
+        WrapTraceMsgError(std::format("Not able to map TTable file: {}", path));
+        return false;
+    }
+
+    LargePageFree(_allocation);
+    _allocation = {ptr, fileSize, static_cast<size_t>(sysconf(_SC_PAGESIZE)), false};
+    _map        = reinterpret_cast<_bucket_t *>(static_cast<char *>(ptr) + _fileHeaderSize);
+#else
+    const LargePageAllocation allocation = LargePageAlloc(header.bucketCount * sizeof(_bucket_t));
+    if (allocation.ptr == nullptr)
+    {
+        WrapTraceMsgError(std::format("Not able to allocate memory for TTable from file: {}", path));
+        return false;
+    }
+
+    std::ifstream stream(path, std::ios::binary);
+    stream.seekg(_fileHeaderSize);
+    stream.read(static_cast<char *>(allocation.ptr), static_cast<std::streamsize>(allocation.size));
+
+    if (!stream)
+    {
+        LargePageFree(allocation);
+        WrapTraceMsgError(std::format("Not able to read TTable file: {}", path));
+        return false;
+    }
+
+    LargePageFree(_allocation);
+    _allocation = allocation;
+    _map        = static_cast<_bucket_t *>(allocation.ptr);
+#endif
+
+    _tableSize  = header.bucketCount;
+    _hashMask   = _getPow2ModuloMask(header.bucketCount);
+    _generation = static_cast<uint8_t>(header.generation);
+
+    GlobalLogger.LogStream << std::format(
+        "info string TTable loaded from file: {}, size: {}MB\n", path, _tableSize * sizeof(_bucket_t) / MB
+    );
+    return true;
+}
+
+bool TranspositionTable::_isFileHeaderValid(const _fileHeader_t &header, const size_t fileSize)
+{
+    return header.magic == _fileMagic && header.formatVersion == _fileFormatVersion &&
+           header.bucketSize == sizeof(_bucket_t) && header.entriesPerBucket == EntriesPerBucket &&
+           header.hashSeed == ZobristHasher::BaseSeed && header.bucketCount != 0 &&
+           std::has_single_bit(header.bucketCount) && header.bucketCount * sizeof(_bucket_t) <= MaxSizeMB * MB &&
+           fileSize == _fileHeaderSize + header.bucketCount * sizeof(_bucket_t);
+}
+
+void TranspositionTable::_parallelClear()
+{
+    const size_t tableBytes = _tableSize * sizeof(_bucket_t);
+    const size_t maxThreads = std::max(1U, std::thread::hardware_concurrency());
+    const size_t threads    = std::clamp(tableBytes / _minClearChunkSize, static_cast<size_t>(1), maxThreads);
+
+    // table size is always power of 2 multiple of bucket size, so every chunk is aligned to the bucket
+    const size_t chunk = (_tableSize + threads - 1) / threads;
+    const auto clearChunk = [this, chunk](const size_t ind)
+    {
+        const size_t start = ind * chunk;
+        const size_t count = std::min(chunk, _tableSize - std::min(start, _tableSize));
+        memset(static_cast<void *>(_map + start), 0, count * sizeof(_bucket_t));
+    };
+
+    std::vector<std::thread> workers{};
+    for (size_t i = 1; i < threads; ++i) workers.emplace_back(clearChunk, i);
+
+    clearChunk(0);
+    for (auto &worker : workers) worker.join();
+
+    _generation = 0;
+}
+
+signed_size_t TranspositionTable::_reallocate(const size_t sizeMB)
+{
+    LargePageFree(_allocation);
     const size_t ceiledSizeMB = std::bit_floor(sizeMB);
-    const size_t objSize      = ceiledSizeMB * MB / sizeof(HashRecord);
-    _map                      = static_cast<HashRecord *>(AlignedAlloc(_entryAlignment, ceiledSizeMB * MB));
+    const size_t objSize      = ceiledSizeMB * MB / sizeof(_bucket_t);
+    _allocate(objSize);
 
     if (_map == nullptr)
     {
-        _map       = static_cast<HashRecord *>(AlignedAlloc(_entryAlignment, StartTableSize * sizeof(HashRecord)));
-        _tableSize = StartTableSize;
-        _hashMask  = _getPow2ModuloMask(StartTableSize);
+        _allocate(StartTableSize);
         _checkForCorrectAlloc(StartTableSize);
-        ClearTable();
 
         WrapTraceMsgError(std::format(
             "Not able to allocate enough memory for TTable, resizing to default size ({}MB)", StartTableSizeMB
@@ -49,37 +258,154 @@ signed_size_t TranspositionTable::ResizeTable(const size_t sizeMB)
         return -1;
     }
 
-    _tableSize = objSize;
-    _hashMask  = _getPow2ModuloMask(objSize);
-    ClearTable();
-
     WrapTraceMsgInfo(std::format("TTable resized to {}MB", ceiledSizeMB));
+    GlobalLogger.LogStream << std::format(
+        "info string TTable uses {}MB of memory backed by {} pages\n", ceiledSizeMB, GetPageSizeStr(_allocation)
+    );
 
     return static_cast<signed_size_t>(ceiledSizeMB);
 }
 
-size_t TranspositionTable::GetContainedElements() const { return _containedRecords; }
+void TranspositionTable::_allocate(const size_t bucketCount)
+{
+    _allocation = LargePageAlloc(bucketCount * sizeof(_bucket_t));
+    _map        = static_cast<_bucket_t *>(_allocation.ptr);
+    _tableSize  = bucketCount;
+    _hashMask   = _getPow2ModuloMask(bucketCount);
+}
+
+size_t TranspositionTable::GetHashFull() const
+{
+    const size_t sampledBuckets = std::min(_tableSize, _hashFullSampleSize / EntriesPerBucket);
+
+    size_t filled{};
+    for (size_t i = 0; i < sampledBuckets; ++i)
+        for (const _sharedEntry_t &sharedEntry : _map[i].entries)
+        {
+            const _entry_t entry = sharedEntry.Load();
+            filled += !entry.IsEmpty() && entry.GetGeneration() == _generation;
+        }
+
+    return filled * 1000 / (sampledBuckets * EntriesPerBucket);
+}
 
 void TranspositionTable::_checkForCorrectAlloc(const size_t size) const
 {
     if (_map == nullptr)
         throw std::runtime_error(
-            std::format("[ ERROR ] Not able to allocate enough memory: {}MB", size * sizeof(HashRecord) / MB)
+            std::format("[ ERROR ] Not able to allocate enough memory: {}MB", size * sizeof(_bucket_t) / MB)
         );
 }
 
+void TranspositionTable::Statistics::Merge(const Statistics &other)
+{
+    for (size_t depth = 0; depth < DepthCount; ++depth)
+    {
+        DepthStats &stats            = PerDepth[depth];
+        const DepthStats &otherStats = other.PerDepth[depth];
+
+        stats.probes += otherStats.probes;
+        for (size_t type = 0; type < NodeTypeCount; ++type)
+        {
+            stats.hits[type] += otherStats.hits[type];
+            stats.cutoffs[type] += otherStats.cutoffs[type];
+            stats.stores[type] += otherStats.stores[type];
+            stats.overwrites[type] += otherStats.overwrites[type];
+        }
+    }
+
+    PawnTable.probes += other.PawnTable.probes;
+    PawnTable.hits += other.PawnTable.hits;
+    MaterialTable.probes += other.MaterialTable.probes;
+    MaterialTable.hits += other.MaterialTable.hits;
+    EvalCache.probes += other.EvalCache.probes;
+    EvalCache.hits += other.EvalCache.hits;
+}
+
+void TranspositionTable::Statistics::Clear()
+{
+    memset(PerDepth, 0, sizeof(PerDepth));
+    PawnTable     = {};
+    MaterialTable = {};
+    EvalCache     = {};
+}
+
+void TranspositionTable::MergeStatistics(Statistics &stats)
+{
+    std::lock_guard lock(_statisticsMutex);
+
+    _statistics.Merge(stats);
+    stats.Clear();
+}
+
 void TranspositionTable::DisplayStatisticsAndReset()
 {
-    const uint64_t totalProbes = _missCount + _hitsCount;
-    double hitRate             = static_cast<double>(_hitsCount) / static_cast<double>(totalProbes);
+    static constexpr const char *NodeTypeNames[Statistics::NodeTypeCount] = {"pv", "lower", "upper"};
+
+    std::lock_guard lock(_statisticsMutex);
+
+    const auto ratio = [](const uint64_t a, const uint64_t b)
+    {
+        return b == 0 ? 0.0 : static_cast<double>(a) / static_cast<double>(b);
+    };
+
+    Statistics::DepthStats total{};
+    for (const auto &stats : _statistics.PerDepth)
+    {
+        total.probes += stats.probes;
+        for (size_t type = 0; type < Statistics::NodeTypeCount; ++type)
+        {
+            total.hits[type] += stats.hits[type];
+            total.cutoffs[type] += stats.cutoffs[type];
+            total.stores[type] += stats.stores[type];
+            total.overwrites[type] += stats.overwrites[type];
+        }
+    }
+
+    const auto sum = [](const uint64_t(&counters)[Statistics::NodeTypeCount])
+    {
+        return std::accumulate(std::begin(counters), std::end(counters), uint64_t{});
+    };
+
+    const uint64_t hits = sum(total.hits);
+    GlobalLogger.LogStream << std::format(
+        "[ TT statistics ] Number of hits: {}, number of misses: {}, total probes: {}, hit-rate: {}, cut-off rate: {}, "
+        "overwrite rate: {}, pages: {}\n",
+        hits, total.probes - hits, total.probes, ratio(hits, total.probes), ratio(sum(total.cutoffs), hits),
+        ratio(sum(total.overwrites), sum(total.stores)), GetPageSizeStr(_allocation)
+    );
+
+    // per depth and node type breakdown: hit rate / cut-off rate / overwrite rate
+    for (size_t depth = 0; depth < Statistics::DepthCount; ++depth)
+    {
+        const Statistics::DepthStats &stats = _statistics.PerDepth[depth];
+        if (stats.probes == 0 && sum(stats.stores) == 0)
+            continue;
+
+        GlobalLogger.LogStream << std::format("[ TT statistics ] depth {:3}: probes {:10}", depth, stats.probes);
+        for (size_t type = 0; type < Statistics::NodeTypeCount; ++type)
+            GlobalLogger.LogStream << std::format(
+                " | {} hit {:.3f} cut {:.3f} overwrite {:.3f}", NodeTypeNames[type],
+                ratio(stats.hits[type], stats.probes), ratio(stats.cutoffs[type], stats.hits[type]),
+                ratio(stats.overwrites[type], stats.stores[type])
+            );
+        GlobalLogger.LogStream << '\n';
+    }
+
+    for (const auto &[name, stats] :
+         {std::pair{"Pawn", _statistics.PawnTable}, std::pair{"Material", _statistics.MaterialTable}})
+        GlobalLogger.LogStream << std::format(
+            "[ TT statistics ] {} table probes: {}, hits: {}, hit-rate: {}\n", name, stats.probes, stats.hits,
+            ratio(stats.hits, stats.probes)
+        );
 
-    GlobalLogger.LogStream
-        << std::format(
-               "[ TT statistics ] Number of hits: {}, number of misses: {}, total probes: {}, hit-rate: {}", _hitsCount,
-               _missCount, totalProbes, hitRate
-           )
-        << std::endl;
+    // every hit of the eval cache is a full evaluation that did not have to be run
+    const auto &evalCache = _statistics.EvalCache;
+    GlobalLogger.LogStream << std::format(
+        "[ TT statistics ] Eval cache probes: {}, hits: {}, hit-rate: {}, evaluations saved: {}\n", evalCache.probes,
+        evalCache.hits, ratio(evalCache.hits, evalCache.probes), evalCache.hits
+    );
+    GlobalLogger.LogStream << std::flush;
 
-    _missCount = 0;
-    _hitsCount = 0;
+    _statistics.Clear();
 }
@@ -219,6 +219,8 @@ UCITranslator::UCICommand UCITranslator::_uciResponse([[maybe_unused]] const std
 
 UCITranslator::UCICommand UCITranslator::_isReadyResponse([[maybe_unused]] const std::string &unused)
 {
+    // answer only when all heavy operations like hash clearing are finished
+    _engine.WaitForBackgroundTasks();
     GlobalLogger.LogStream << "readyok" << std::endl;
     return UCICommand::isreadyCommand;
 }
@@ -357,7 +359,9 @@ UCITranslator::UCICommand UCITranslator::_goSearchPerftResponse(const std::strin
     if (pos != ParseTools::InvalidNextWorldRead)
         ParseTools::ExtractNextWord(str, file2Str, pos);
 
-    bool result = SearchPerfTester::PerformSearchPerfTest(file1Str, file2Str, _engine.TManager.GetDefaultStack());
+    bool result = SearchPerfTester::PerformSearchPerfTest(
+        file1Str, file2Str, _engine.TManager.GetDefaultStack(), _engine.TManager.GetDefaultEvalTables()
+    );
     if (!result)
         return UCICommand::InvalidCommand;
     return UCICommand::goCommand;
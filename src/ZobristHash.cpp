@@ -3,6 +3,7 @@
 //
 
 #include "../include/Search/ZobristHash.h"
+#include "../include/Interface/Logger.h"
 
 #include <random>
 
@@ -40,6 +41,38 @@ uint64_t ZobristHasher::GenerateHash(const Board &board) const
 
     return hash;
 }
+
+uint64_t ZobristHasher::GeneratePawnHash(const Board &board) const
+{
+    uint64_t hash{};
+
+    for (const size_t boardInd : {wPawnsIndex, bPawnsIndex})
+        for (uint64_t boardMap = board.BitBoards[boardInd]; boardMap; boardMap ^= ExtractLsbBit(boardMap))
+            hash ^= _pawnHashes[boardInd][ExtractMsbPos(ExtractLsbBit(boardMap))];
+
+    return hash;
+}
+
+uint64_t ZobristHasher::GenerateMaterialHash(const Board &board) const
+{
+    uint64_t hash{};
+
+    for (size_t boardInd = 0; boardInd < Board::BitBoardsCount; ++boardInd)
+    {
+        const int count = CountOnesInBoard(board.BitBoards[boardInd]);
+        for (int figureNum = 0; figureNum < count; ++figureNum) hash ^= _materialHashes[boardInd][figureNum];
+    }
+
+    return hash;
+}
+
+void ZobristHasher::RecomputeHashes(Board &board) const
+{
+    board.ZobristKey  = GenerateHash(board);
+    board.PawnKey     = GeneratePawnHash(board);
+    board.MaterialKey = GenerateMaterialHash(board);
+}
+
 void ZobristHasher::RollParameters(const uint64_t seed)
 {
     std::mt19937_64 randEngine{seed};
@@ -62,6 +95,14 @@ void ZobristHasher::RollParameters(const uint64_t seed)
 
     // filling el passant BitBoards
     for (auto &_elPassantHash : _elPassantHashes) _elPassantHash = randEngine();
+
+    // pawn hashes reuse the main ones, other boards stay zeroed
+    for (const size_t bd : {wPawnsIndex, bPawnsIndex})
+        for (size_t field = 0; field < Board::BitBoardFields; ++field) _pawnHashes[bd][field] = _mainHashes[bd][field];
+
+    // filling material hashes except sentinel board
+    for (size_t bd = 0; bd < Board::BitBoardsCount; ++bd)
+        for (auto &materialHash : _materialHashes[bd]) materialHash = randEngine();
 }
 
 #define CheckNum(a, b)                                                                                                 \
@@ -32,3 +32,74 @@ TEST(BoardEvaluator, NeutralPosition)
     // Assert
     ASSERT_EQ(eval, 0);
 }
+
+class BoardEvaluatorTables : public testing::TestWithParam<const char *>
+{
+};
+
+TEST_P(BoardEvaluatorTables, TablesMatchDirectEvaluation)
+{
+    // Arrange
+    const char *fen = GetParam();
+
+    Board board{};
+    ASSERT_TRUE(FenTranslator::Translate(fen, board));
+    const PositionInfo info = ChessMechanics{board}.GetPositionInfo();
+
+    const auto pawnTable     = std::make_unique<PawnHashTable>();
+    const auto materialTable = std::make_unique<MaterialHashTable>();
+
+    // Act
+    const int direct = BoardEvaluator::DefaultFullEvalFunction(board, board.MovingColor, info);
+    const int missed =
+        BoardEvaluator::DefaultFullEvalFunction(board, board.MovingColor, info, pawnTable.get(), materialTable.get());
+    const uint64_t pawnProbes = pawnTable->GetProbes();
+    const uint64_t pawnHits   = pawnTable->GetHits();
+    const int hit =
+        BoardEvaluator::DefaultFullEvalFunction(board, board.MovingColor, info, pawnTable.get(), materialTable.get());
+
+    // Assert
+    EXPECT_EQ(direct, missed);
+    EXPECT_EQ(direct, hit);
+
+    EXPECT_EQ(materialTable->GetProbes(), 2);
+    EXPECT_EQ(materialTable->GetHits(), 1);
+
+    // drawn material and known endgames skip the pawn table, otherwise the second evaluation has to hit it
+    EXPECT_EQ(pawnTable->GetProbes() - pawnProbes, pawnTable->GetHits() - pawnHits);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    BoardEvaluator, BoardEvaluatorTables,
+    testing::Values(
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "4k2r/8/8/1b6/8/3P4/4K2R/8 w - - 0 1", // pinned pawn
+        "8/5pk1/6p1/2P5/1P6/8/6K1/8 b - - 0 1",
+        "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+        "4k3/8/8/8/8/8/8/1N2K3 w - - 0 1",      // drawn material
+        "QQQQ4/QQQ5/8/8/4k3/8/8/4K3 w - - 0 1", // exceeds the precomputed material table
+        "8/8/8/4k3/8/8/8/R3K3 b - - 0 1"        // known endgame
+    )
+);
+
+TEST(BoardEvaluator, KnownEndgamesDriveKingToMate)
+{
+    // Arrange
+    const auto eval = [](const char *fen)
+    {
+        Board board = FenTranslator::GetTranslated(fen);
+        return BoardEvaluator::Evaluation2(board);
+    };
+
+    // Act & Assert
+
+    // KRK: lonely king on the edge is closer to be mated than the centralized one
+    EXPECT_GT(eval("4k3/8/4K3/8/8/8/8/R7 w - - 0 1"), eval("8/8/8/4k3/8/8/8/R3K3 w - - 0 1"));
+    EXPECT_LT(eval("4K3/8/4k3/8/8/8/8/r7 w - - 0 1"), eval("8/8/8/4K3/8/8/8/r3k3 w - - 0 1"));
+    EXPECT_EQ(eval("4k3/8/4K3/8/8/8/8/R7 w - - 0 1"), -eval("4K3/8/4k3/8/8/8/8/r7 w - - 0 1"));
+
+    // KBNK: only the corner of the bishop color allows to mate
+    EXPECT_GT(eval("k7/8/1K6/8/8/8/8/NB6 w - - 0 1"), eval("7k/8/6K1/8/8/8/8/NB6 w - - 0 1"));
+    EXPECT_GT(eval("7k/8/6K1/8/8/8/8/NB6 w - - 0 1"), 0);
+}
@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <random>
+#include <set>
+
+#include "../include/MapTypes/FancyMagicBishopMap.h"
+#include "../include/MapTypes/FancyMagicRookMap.h"
+#include "../include/MapTypes/PextMap.h"
 #include "../include/MoveGeneration/MoveGenerator.h"
 #include "../include/Search/BestMoveSearch.h"
 #include "../include/TestsAndDebugging/DebugTools.h"
@@ -29,13 +35,6 @@ TEST(ChessMechTests, Draw50Test)
 
 TEST(ChessMechTests, ThreeFoldRepetition)
 {
-    auto counter = [](std::unordered_map<uint64_t, int> &map) -> int
-    {
-        int sum{};
-        for (auto [key, count] : map) sum += count;
-        return sum;
-    };
-
     TestSetup setup{};
 
     setup.Initialize();
@@ -43,20 +42,20 @@ TEST(ChessMechTests, ThreeFoldRepetition)
     setup.ProcessCommandSync("position startpos moves g1f3 b8c6 f3g1 c6b8 g1f3 b8c6 f3g1 c6b8");
     Board bd = setup.GetEngine().GetUnderlyingBoardCopy();
     EXPECT_TRUE(IsDrawDebug(bd));
-    EXPECT_EQ(counter(bd.Repetitions), 9);
+    EXPECT_EQ(bd.RepetitionKeysCount, 9);
 
     setup.ProcessCommandSync("position fen rnbqkbnr/pppppppp/Q7/8/8/8/PPPPPPPP/RNB1KBNR b KQkq - 0 1 moves b8c6 g1f3 "
                              "c6b8 f3g1 b8c6 g1f3 c6b8 f3g1");
     bd = setup.GetEngine().GetUnderlyingBoardCopy();
     EXPECT_TRUE(IsDrawDebug(bd));
-    EXPECT_EQ(counter(bd.Repetitions), 9);
+    EXPECT_EQ(bd.RepetitionKeysCount, 9);
 
     setup.ProcessCommandSync(
         "position fen rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNB1KBNR b KQkq - 0 1 moves b8c6 g1f3 c6b8 f3g1 b8c6 g1f3 c6b8"
     );
     bd = setup.GetEngine().GetUnderlyingBoardCopy();
     EXPECT_TRUE(!IsDrawDebug(bd));
-    EXPECT_EQ(counter(bd.Repetitions), 8);
+    EXPECT_EQ(bd.RepetitionKeysCount, 8);
 
     Stack<Move, DEFAULT_STACK_SIZE> s;
     BestMoveSearch searcher{bd, s};
@@ -64,6 +63,33 @@ TEST(ChessMechTests, ThreeFoldRepetition)
     EXPECT_EQ(searcher.IterativeDeepening(nullptr, nullptr, 5, false), 0);
 }
 
+TEST(ChessMechTests, ParallelPerft)
+{
+    const auto sum = [](const std::map<std::string, uint64_t> &moves) -> uint64_t
+    {
+        uint64_t total{};
+        for (const auto &[move, count] : moves) total += count;
+        return total;
+    };
+
+    TestSetup setup{};
+
+    setup.Initialize();
+
+    setup.ProcessCommandSync("position fen r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    const auto singleThreaded = setup.GetEngine().GetPerft(3);
+    EXPECT_EQ(sum(singleThreaded), 97862);
+
+    setup.ProcessCommandSync("setoption name Threads value 4");
+    setup.ProcessCommandSync("setoption name Perft Hash value 16");
+
+    // second run is served mostly from the perft hash
+    EXPECT_EQ(setup.GetEngine().GetPerft(3), singleThreaded);
+    EXPECT_EQ(setup.GetEngine().GetPerft(3), singleThreaded);
+
+    setup.ProcessCommandSync("setoption name Threads value 1");
+}
+
 TEST(ChessMechTests, SEE1)
 {
     static const char *positions[]{
@@ -82,4 +108,186 @@ TEST(ChessMechTests, SEE1)
 
         EXPECT_EQ(mech.SEE(mv), scores[i] / SCORE_GRAIN);
     }
-}
\ No newline at end of file
+}
+
+TEST(ChessMechTests, SEEGeMatchesSEE)
+{
+    static const char *positions[]{
+        "1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1",
+        "1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "r1bq1rk1/pp2nppp/2n1p3/3pP3/1b1P4/2NB1N2/PP3PPP/R1BQK2R w KQ - 0 1",
+        "3r2k1/5ppp/8/3q4/3R4/3R4/3Q2PP/6K1 w - - 0 1",
+    };
+
+    Stack<Move, DEFAULT_STACK_SIZE> s;
+
+    for (const char *position : positions)
+    {
+        const Board bd = FenTranslator::GetTranslated(position);
+        MoveGenerator gen{bd, s};
+
+        auto moves = gen.GetMovesFast();
+        for (size_t i = 0; i < moves.size; ++i)
+        {
+            const int see = gen.SEE(moves[i]);
+
+            for (const int threshold : {see - 1, see, see + 1, SEE_GOOD_MOVE_BOUNDARY, 0, 1, -50, 50})
+                EXPECT_EQ(gen.SEEGe(moves[i], threshold), see >= threshold)
+                    << position << ' ' << moves[i].GetLongAlgebraicNotation() << ' ' << threshold;
+        }
+        s.PopAggregate(moves);
+    }
+}
+
+TEST(ChessMechTests, PextMapsMatchFancyMagicMaps)
+{
+    static constexpr FancyMagicRookMap fancyRookMap{};
+    static constexpr FancyMagicBishopMap fancyBishopMap{};
+    static constexpr PextRookMap pextRookMap{};
+    static constexpr PextBishopMap pextBishopMap{};
+    static constexpr int BoardsPerField = 1024;
+
+    std::mt19937_64 rng{2137};
+    for (int msbInd = 0; msbInd < static_cast<int>(Board::BitBoardFields); ++msbInd)
+        for (int i = 0; i < BoardsPerField; ++i)
+        {
+            // sparse and dense boards
+            const uint64_t fullBoard = i % 2 == 0 ? rng() & rng() : rng() | rng();
+
+            EXPECT_EQ(pextRookMap.GetMoves(msbInd, fullBoard), fancyRookMap.GetMoves(msbInd, fullBoard));
+            EXPECT_EQ(pextBishopMap.GetMoves(msbInd, fullBoard), fancyBishopMap.GetMoves(msbInd, fullBoard));
+        }
+}
+
+TEST(ChessMechTests, PieceOnSquareFollowsBitBoards)
+{
+    static const char *positions[]{
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    };
+    static constexpr int PlayoutsPerPosition = 64;
+    static constexpr int PlayoutLength       = 64;
+
+    Stack<Move, DEFAULT_STACK_SIZE> s;
+    std::mt19937_64 rng{2137};
+
+    for (const char *position : positions)
+        for (int playout = 0; playout < PlayoutsPerPosition; ++playout)
+        {
+            const Board initial = FenTranslator::GetTranslated(position);
+            Board bd            = initial;
+
+            std::vector<std::pair<Move, VolatileBoardData>> played{};
+            for (int ply = 0; ply < PlayoutLength; ++ply)
+            {
+                MoveGenerator gen{bd, s};
+                auto moves = gen.GetMovesFast<false, false>();
+
+                if (moves.size == 0)
+                {
+                    s.PopAggregate(moves);
+                    break;
+                }
+
+                const Move mv = moves[rng() % moves.size];
+                s.PopAggregate(moves);
+
+                played.emplace_back(mv, VolatileBoardData{bd});
+                Move::MakeMove(mv, bd);
+
+                Board recomputed = bd;
+                recomputed.RecomputePieceOnSquare();
+                ASSERT_EQ(bd.PieceOnSquare, recomputed.PieceOnSquare)
+                    << position << " " << mv.GetLongAlgebraicNotation();
+            }
+
+            for (auto it = played.rbegin(); it != played.rend(); ++it) Move::UnmakeMove(it->first, bd, it->second);
+            EXPECT_TRUE(Board::Comp(bd, initial));
+        }
+}
+
+TEST(ChessMechTests, QuietChecksMatchFilteredQuietMoves)
+{
+    static const char *positions[]{
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "4k3/8/8/8/1B6/2N5/3R4/R3K3 w Q - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "3k4/8/8/3N4/8/8/3R4/4K3 w - - 0 1",
+        "8/8/8/2k5/8/8/3P4/4K3 w - - 0 1",
+    };
+
+    Stack<Move, DEFAULT_STACK_SIZE> s;
+
+    const auto isGivingCheck = [](Board bd, const Move mv)
+    {
+        Move::MakeMove(mv, bd);
+        return ChessMechanics{bd}.IsCheck();
+    };
+
+    for (const char *position : positions)
+    {
+        const Board bd = FenTranslator::GetTranslated(position);
+        MoveGenerator gen{bd, s};
+
+        std::set<uint16_t> expected{};
+        auto quiets = gen.GetMovesFast<false, false, true>();
+        for (size_t i = 0; i < quiets.size; ++i)
+            if (isGivingCheck(bd, quiets[i]))
+                expected.insert(quiets[i].GetPackedMove().DumpContent());
+        s.PopAggregate(quiets);
+
+        std::set<uint16_t> returned{};
+        auto checks = gen.GetQuietChecksFast<false>();
+        for (size_t i = 0; i < checks.size; ++i)
+            returned.insert(checks[i].GetPackedMove().DumpContent());
+        s.PopAggregate(checks);
+
+        EXPECT_EQ(returned, expected) << position;
+    }
+}
+
+TEST(ChessMechTests, PositionInfoChecksAndPins)
+{
+    // white bishop pinned on the e file, black knight pinned on the diagonal, white king checked by the queen
+    const Board bd = FenTranslator::GetTranslated("4k3/3nr3/8/8/Q6q/8/4B3/4K3 w - - 0 1");
+    const PositionInfo info = ChessMechanics{bd}.GetPositionInfo();
+
+    EXPECT_TRUE(info.IsCheck());
+    EXPECT_EQ(info.ChecksCount, 1);
+    EXPECT_EQ(info.CheckType, ChessMechanics::slidingFigCheck);
+    EXPECT_EQ(info.Checkers, ExtractPosFromStr('h', '4'));
+    EXPECT_EQ(info.PinnedFigs, ExtractPosFromStr('e', '2'));
+    EXPECT_NE(info.BlockedFields & ExtractPosFromStr('f', '2'), 0);
+    EXPECT_EQ(info.FullMap, info.ColorMaps[WHITE] | info.ColorMaps[BLACK]);
+
+    // pins and attacks of the side not to move are collected only on demand
+    const ChessMechanics mech{bd};
+    EXPECT_EQ(
+        mech.GetPinnedFigsMap<ChessMechanics::PinnedFigGen::WoutAllowedTiles>(BLACK, info.FullMap).first,
+        ExtractPosFromStr('d', '7')
+    );
+
+    PositionInfo fullInfo = info;
+    mech.CollectAttacks(fullInfo, WHITE);
+    EXPECT_EQ(fullInfo.Attacks[BLACK], info.Attacks[BLACK]);
+    EXPECT_NE(fullInfo.Attacks[WHITE][queensIndex] & ExtractPosFromStr('h', '4'), 0);
+    EXPECT_NE(fullInfo.Attacks[WHITE][queensIndex] & ExtractPosFromStr('d', '7'), 0);
+    EXPECT_EQ(fullInfo.Attacks[WHITE][queensIndex] & ExtractPosFromStr('e', '8'), 0);
+
+    // pinned bishop can not block the check, so only capture of the checker and king moves remain
+    Stack<Move, DEFAULT_STACK_SIZE> s;
+    MoveGenerator gen{bd, s, {}, {}, {}, 0, 0, &info};
+    auto moves = gen.GetMovesFast<false, false>();
+
+    const std::set<std::string> expected{"a4h4", "e1d1", "e1d2", "e1f1"};
+
+    std::set<std::string> generated{};
+    for (size_t i = 0; i < moves.size; ++i) generated.insert(moves[i].GetLongAlgebraicNotation());
+    s.PopAggregate(moves);
+
+    EXPECT_EQ(generated, expected);
+}
@@ -1,25 +1,39 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "../include/Evaluation/BoardEvaluator.h"
+#include "../include/Evaluation/EvalCache.h"
 #include "../include/MoveGeneration/MoveGenerator.h"
 #include "../include/ParseTools.h"
 #include "../include/Search/BestMoveSearch.h"
+#include "../include/Search/MovePicker.h"
+#include "../include/Search/TranspositionTable.h"
 #include "../include/Search/ZobristHash.h"
 #include "../include/TestsAndDebugging/DebugTools.h"
 #include "../include/TestsAndDebugging/TestSetup.h"
+#include "../include/ThreadManagement/GameTimeManager.h"
 
 TEST(TranspositionTableTests, HashFunctionTest1)
 {
     std::vector<std::string> posCommand{
-        "position fen r2q2k1/1ppbb3/p3pr2/1P1p2p1/3P2P1/P1NQ1N2/2P2P2/R3K2R w KQ - 0 18", "position startpos"
+        "position fen r2q2k1/1ppbb3/p3pr2/1P1p2p1/3P2P1/P1NQ1N2/2P2P2/R3K2R w KQ - 0 18", "position startpos",
+        "position fen n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1", "position startpos"
     };
 
     std::vector<std::vector<std::string>> movesSubCommands{
         {"d3h7", "g8f8", "h7h8", "f8f7"},
         ParseTools::Split("g1f3 b7b6 e2e4 c8b7 b1c3 e7e6 a2a3 g8f6 e4e5 f6d5 f1c4 d5c3 d2c3 d7d6 c1g5 f8e7 g5e7 d8e7 "
                           "e5d6 c7d6 e1g1 e8g8"),
+        {"g2h1q", "b7a8q", "h1f1", "e2f1"},
+        {"e2e4", "a7a6", "e4e5", "d7d5", "e5d6"},
     };
 
     for (size_t i = 0; i < posCommand.size(); ++i)
@@ -31,7 +45,6 @@ TEST(TranspositionTableTests, HashFunctionTest1)
         setup.Initialize();
 
         setup.ProcessCommandSync(position);
-        uint64_t hash = ZHasher.GenerateHash(setup.GetEngine().GetUnderlyingBoardCopy());
 
         std::string mvSubCommand = " moves ";
         for (const std::string &mv : moves)
@@ -39,19 +52,401 @@ TEST(TranspositionTableTests, HashFunctionTest1)
             mvSubCommand += mv + ' ';
             const std::string fullCommand = position + mvSubCommand;
 
-            const Board bd = setup.GetEngine().GetUnderlyingBoardCopy();
+            Board bd = setup.GetEngine().GetUnderlyingBoardCopy();
             const VolatileBoardData vd{bd};
 
             Move currMove = GetMoveDebug(bd, mv);
             EXPECT_EQ(currMove.GetLongAlgebraicNotation(), mv);
 
             setup.ProcessCommandSync(fullCommand);
+            const Board genBoard = setup.GetEngine().GetUnderlyingBoardCopy();
 
-            const uint64_t genHash = ZHasher.GenerateHash(setup.GetEngine().GetUnderlyingBoardCopy());
-            hash                   = ZHasher.UpdateHash(hash, currMove, vd);
+            // incrementally updated hashes should be same as generated ones
+            Move::MakeMove(currMove, bd);
+            EXPECT_EQ(bd.ZobristKey, ZHasher.GenerateHash(genBoard));
+            EXPECT_EQ(bd.PawnKey, ZHasher.GeneratePawnHash(genBoard));
+            EXPECT_EQ(bd.MaterialKey, ZHasher.GenerateMaterialHash(genBoard));
 
-            // Generated hash should be same as normal hash
-            EXPECT_EQ(hash, genHash);
+            // so should be the evaluation sums
+            Board recomputed = genBoard;
+            PieceSquareTables::Recompute(recomputed);
+            EXPECT_EQ(bd.PsqtMidgame, recomputed.PsqtMidgame);
+            EXPECT_EQ(bd.PsqtEndgame, recomputed.PsqtEndgame);
+            EXPECT_EQ(bd.PhaseWeights, recomputed.PhaseWeights);
+
+            // and restored after the move is reverted
+            Move::UnmakeMove(currMove, bd, vd);
+            EXPECT_EQ(bd.ZobristKey, vd.ZobristKey);
+            EXPECT_EQ(bd.PsqtMidgame, vd.PsqtMidgame);
+        }
+    }
+}
+
+TEST(TranspositionTableTests, BucketReplacement)
+{
+    TTable.ClearTable();
+
+    PackedMove mv{};
+    mv.SetStartField(12);
+    mv.SetTargetField(28);
+
+    // all hashes land inside the same bucket
+    const auto hash = [](const uint64_t i)
+    {
+        return 0x1234LLU | (i << 48);
+    };
+
+    // deep entry should survive many shallow stores of the same search
+    TTable.Add({hash(0), mv, 10, 5, 20, PV_NODE, 0}, hash(0));
+    for (uint64_t i = 1; i < 16; ++i) TTable.Add({hash(i), mv, 10, 5, 0, LOWER_BOUND, 0}, hash(i));
+
+    const auto record = TTable.GetRecord(hash(0));
+    ASSERT_TRUE(record.IsSameHash(hash(0)));
+    EXPECT_EQ(record.GetDepth(), 20);
+    EXPECT_EQ(record.GetMove(), mv);
+    EXPECT_EQ(record.GetEval(), 10);
+    EXPECT_EQ(record.GetStatVal(), 5);
+    EXPECT_EQ(record.GetNodeType(), PV_NODE);
+
+    // after few searches the entry gets outdated and is replaced
+    for (int i = 0; i < 3; ++i) TTable.IncrementGeneration();
+    for (uint64_t i = 16; i < 20; ++i) TTable.Add({hash(i), mv, 10, 5, 0, LOWER_BOUND, 0}, hash(i));
+
+    EXPECT_FALSE(TTable.GetRecord(hash(0)).IsSameHash(hash(0)));
+    EXPECT_TRUE(TTable.GetRecord(hash(19)).IsSameHash(hash(19)));
+
+    TTable.ClearTable();
+}
+
+TEST(TranspositionTableTests, ConcurrentAccessStressTest)
+{
+    static constexpr size_t ThreadCount   = 8;
+    static constexpr size_t Iterations    = 200'000;
+    static constexpr size_t HashPoolSize  = 4096;
+    static constexpr size_t UsedBuckets   = 64;
+    static constexpr uint64_t BucketsMask = 0x3FFF;
+
+    TranspositionTable table{};
+    table.ResizeTable(1);
+
+    // all hashes are squeezed into a few buckets to provoke as many concurrent writes to same entries as possible
+    std::mt19937_64 gen{42};
+    std::vector<uint64_t> hashes(HashPoolSize);
+    for (auto &hash : hashes) hash = (gen() & ~BucketsMask) | (gen() % UsedBuckets);
+
+    // every record content is derived from its hash, so any mixed record is detectable
+    const auto makeRecord = [](const uint64_t hash)
+    {
+        PackedMove mv{};
+        mv.SetStartField(1 + hash % 63);
+        mv.SetTargetField((hash >> 6) % 64);
+
+        const int eval    = static_cast<int>((hash >> 12) % 2000) - 1000;
+        const int statVal = static_cast<int>((hash >> 24) % 2000) - 1000;
+        const int depth   = static_cast<int>((hash >> 36) % 64);
+        const auto nType  = (hash >> 42) & 1 ? PV_NODE : LOWER_BOUND;
+        return TranspositionTable::HashRecord{hash, mv, eval, statVal, depth, nType, 0};
+    };
+
+    std::atomic<uint64_t> corruptedReads{};
+    std::atomic<uint64_t> hits{};
+
+    const auto worker = [&](const size_t threadInd)
+    {
+        std::mt19937_64 rng{threadInd};
+
+        for (size_t i = 0; i < Iterations; ++i)
+        {
+            const uint64_t hash = hashes[rng() % HashPoolSize];
+
+            if (const uint64_t action = rng() % 3; action == 0)
+            {
+                table.Add(makeRecord(hash), hash);
+                continue;
+            }
+            else if (action == 1)
+            {
+                table.SetStatVal(hash, makeRecord(hash).GetStatVal());
+                continue;
+            }
+
+            const auto record = table.GetRecord(hash);
+            if (!record.IsSameHash(hash))
+                continue;
+
+            const auto expected = makeRecord(hash);
+            hits.fetch_add(1, std::memory_order_relaxed);
+            if (record.GetMove() != expected.GetMove() || record.GetEval() != expected.GetEval() ||
+                record.GetStatVal() != expected.GetStatVal() || record.GetDepth() != expected.GetDepth() ||
+                record.GetNodeType() != expected.GetNodeType())
+                corruptedReads.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> threads{};
+    for (size_t i = 0; i < ThreadCount; ++i) threads.emplace_back(worker, i);
+    for (auto &thread : threads) thread.join();
+
+    EXPECT_GT(hits.load(), 0);
+    EXPECT_EQ(corruptedReads.load(), 0);
+}
+
+TEST(TranspositionTableTests, AsyncResizeAndClear)
+{
+    TranspositionTable table{};
+
+    PackedMove mv{};
+    mv.SetStartField(12);
+    mv.SetTargetField(28);
+
+    ASSERT_EQ(table.ResizeTableAsync(256), 256);
+    table.WaitForReady();
+    ASSERT_TRUE(table.IsReady());
+    EXPECT_EQ(table.GetHashFull(), 0);
+
+    table.Add({0x1234, mv, 10, 5, 4, PV_NODE, 0}, 0x1234);
+    ASSERT_TRUE(table.GetRecord(0x1234).IsSameHash(0x1234));
+
+    table.ClearTableAsync();
+    table.WaitForReady();
+    EXPECT_FALSE(table.GetRecord(0x1234).IsSameHash(0x1234));
+    EXPECT_EQ(table.GetHashFull(), 0);
+}
+
+TEST(TranspositionTableTests, HashFullCountsCurrentGeneration)
+{
+    // more positions than entries inside the bucket, so every used bucket gets filled completely
+    static constexpr uint64_t PositionsPerBucket = 8;
+
+    TranspositionTable table{};
+    table.ResizeTable(1);
+
+    PackedMove mv{};
+    mv.SetStartField(12);
+    mv.SetTargetField(28);
+
+    // fills every bucket with given index parity, only the sampled prefix of the table matters
+    const auto fillBuckets = [&](const uint64_t parity)
+    {
+        for (uint64_t bucket = parity; bucket < 4096; bucket += 2)
+            for (uint64_t i = 1; i <= PositionsPerBucket; ++i)
+            {
+                const uint64_t hash = bucket | (i << 40);
+                table.Add({hash, mv, 10, 5, 4, PV_NODE, 0}, hash);
+            }
+    };
+
+    EXPECT_EQ(table.GetHashFull(), 0);
+
+    fillBuckets(0);
+    EXPECT_EQ(table.GetHashFull(), 500);
+
+    // entries of previous searches are not counted
+    table.IncrementGeneration();
+    EXPECT_EQ(table.GetHashFull(), 0);
+
+    fillBuckets(1);
+    EXPECT_EQ(table.GetHashFull(), 500);
+}
+
+TEST(TranspositionTableTests, StatisticsMerge)
+{
+    TranspositionTable::Statistics total{};
+    TranspositionTable::Statistics other{};
+
+    total.RecordProbe(3, true, PV_NODE);
+    total.RecordStore(3, LOWER_BOUND, false);
+    total.PawnTable = {10, 7};
+
+    other.RecordProbe(3, true, PV_NODE);
+    other.RecordProbe(3, false, PV_NODE);
+    other.RecordCutoff(3, PV_NODE);
+    other.RecordStore(3, LOWER_BOUND, true);
+    other.RecordProbe(MAX_SEARCH_DEPTH + 10, true, UPPER_BOUND);
+    other.PawnTable     = {5, 2};
+    other.MaterialTable = {4, 4};
+    other.EvalCache     = {8, 1};
+
+    total.Merge(other);
+
+    const auto &depth = total.PerDepth[3];
+    EXPECT_EQ(depth.probes, 3);
+    EXPECT_EQ(depth.hits[PV_NODE], 2);
+    EXPECT_EQ(depth.cutoffs[PV_NODE], 1);
+    EXPECT_EQ(depth.stores[LOWER_BOUND], 2);
+    EXPECT_EQ(depth.overwrites[LOWER_BOUND], 1);
+
+    // too deep probes are gathered inside the last slot
+    const auto &deepest = total.PerDepth[TranspositionTable::Statistics::DepthCount - 1];
+    EXPECT_EQ(deepest.probes, 1);
+    EXPECT_EQ(deepest.hits[UPPER_BOUND], 1);
+
+    EXPECT_EQ(total.PawnTable.probes, 15);
+    EXPECT_EQ(total.PawnTable.hits, 9);
+    EXPECT_EQ(total.MaterialTable.hits, 4);
+    EXPECT_EQ(total.EvalCache.probes, 8);
+
+    total.Clear();
+    EXPECT_EQ(total.PerDepth[3].probes, 0);
+    EXPECT_EQ(total.PawnTable.probes, 0);
+    EXPECT_EQ(total.EvalCache.hits, 0);
+}
+
+TEST(TranspositionTableTests, SaveAndLoadFile)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "checkmate_chariot_tt_test.tt").string();
+
+    PackedMove mv{};
+    mv.SetStartField(12);
+    mv.SetTargetField(28);
+
+    {
+        TranspositionTable table{};
+        table.ResizeTable(32);
+        table.IncrementGeneration();
+        table.Add({0x1234, mv, 10, 5, 17, PV_NODE, 0}, 0x1234);
+        ASSERT_TRUE(table.SaveToFile(path));
+    }
+
+    TranspositionTable table{};
+    ASSERT_TRUE(table.LoadFromFile(path));
+
+    const auto record = table.GetRecord(0x1234);
+    ASSERT_TRUE(record.IsSameHash(0x1234));
+    EXPECT_EQ(record.GetMove(), mv);
+    EXPECT_EQ(record.GetDepth(), 17);
+
+    // loaded table should be fully functional
+    table.Add({0x4321, mv, 10, 5, 3, LOWER_BOUND, 0}, 0x4321);
+    EXPECT_TRUE(table.GetRecord(0x4321).IsSameHash(0x4321));
+
+    // corrupted files should be rejected
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 64);
+    EXPECT_FALSE(table.LoadFromFile(path));
+    EXPECT_TRUE(table.GetRecord(0x4321).IsSameHash(0x4321));
+
+    std::filesystem::remove(path);
+}
+
+TEST(MovePickerTests, ReturnsEveryLegalMoveOnce)
+{
+    static const char *positions[]{
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "4k3/8/8/8/8/8/4r3/R3K2R w KQ - 0 1",
+    };
+
+    // the stack is too big to be placed on the thread stack
+    const auto stack = std::make_unique<MoveGenerator::stck>();
+
+    for (const char *position : positions)
+    {
+        const Board bd = FenTranslator::GetTranslated(position);
+
+        std::multiset<std::string> expected{};
+        MoveGenerator gen{bd, *stack};
+        auto moves = gen.GetMovesFast<false, false>();
+        for (size_t i = 0; i < moves.size; ++i) expected.insert(moves[i].GetLongAlgebraicNotation());
+        const PackedMove legalHashMove = moves[moves.size - 1].GetPackedMove();
+        stack->PopAggregate(moves);
+
+        // second hash move comes from other position, so it is most likely illegal here
+        const Board otherBd = FenTranslator::GetTranslated(positions[0]);
+        MoveGenerator otherGen{otherBd, *stack};
+        auto otherMoves                = otherGen.GetMovesFast<false, false>();
+        const PackedMove otherHashMove = otherMoves[0].GetPackedMove();
+        stack->PopAggregate(otherMoves);
+
+        for (const PackedMove hashMove : {PackedMove{}, legalHashMove, otherHashMove})
+        {
+            std::multiset<std::string> picked{};
+            MovePicker picker{bd, *stack, hashMove};
+
+            Move mv = picker.GetNext();
+            if (!hashMove.IsEmpty() && expected.contains(hashMove.GetLongAlgebraicNotation()))
+                EXPECT_EQ(mv.GetPackedMove(), hashMove);
+
+            for (; !mv.IsEmpty(); mv = picker.GetNext()) picked.insert(mv.GetLongAlgebraicNotation());
+
+            EXPECT_EQ(picked, expected) << position;
         }
     }
 }
+
+TEST(EvalCacheTests, StoresEvalUnderUpperKeyBits)
+{
+    EvalCache cache{1};
+    ASSERT_TRUE(cache.IsEnabled());
+
+    int eval{};
+    const uint64_t hash = 0x9E3779B97F4A7C15ULL;
+    EXPECT_FALSE(cache.Probe(hash, eval));
+
+    cache.Store(hash, -1234);
+    ASSERT_TRUE(cache.Probe(hash, eval));
+    EXPECT_EQ(eval, -1234);
+
+    // same slot but different upper bits must not be mistaken for the stored position
+    EXPECT_FALSE(cache.Probe(hash ^ (1ULL << 63), eval));
+
+    EXPECT_EQ(cache.GetProbes(), 3);
+    EXPECT_EQ(cache.GetHits(), 1);
+
+    cache.Resize(0);
+    EXPECT_FALSE(cache.IsEnabled());
+}
+
+TEST(EvalCacheTests, SearchResultDoesNotDependOnCache)
+{
+    static constexpr int Depth = 5;
+    const Board bd   = FenTranslator::GetTranslated(
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"
+    );
+    const auto stack = std::make_unique<MoveGenerator::stck>();
+
+    GameTimeManager::StartTimerAsync();
+
+    const auto search = [&](BestMoveSearch::EvalTables *tables)
+    {
+        TTable.ClearTable();
+        GameTimeManager::StartSearchManagementAsync(GoTimeInfo::GetInfiniteTime(), WHITE, bd, bd.Age);
+
+        PackedMove bestMove{};
+        BestMoveSearch searcher{bd, *stack, 0, nullptr, 1, tables};
+        const int eval = searcher.IterativeDeepening(&bestMove, nullptr, Depth, false);
+        GameTimeManager::StopSearchManagement();
+
+        return std::pair{eval, bestMove};
+    };
+
+    const auto expected = search(nullptr);
+
+    // cached evals are exactly the computed ones, so the searched tree has to stay the same, also with warm cache
+    const auto tables = std::make_unique<BestMoveSearch::EvalTables>(1);
+    EXPECT_EQ(search(tables.get()), expected);
+    EXPECT_EQ(search(tables.get()), expected);
+
+    // with the TT emptied the second quiesce search visits the same positions, so all of them come from the cache
+    const auto rootTables = std::make_unique<BestMoveSearch::EvalTables>(1);
+    EvalCache &rootCache  = rootTables->Cache;
+    GameTimeManager::StartSearchManagementAsync(GoTimeInfo::GetInfiniteTime(), WHITE, bd, bd.Age);
+    for (const bool isWarm : {false, true})
+    {
+        TTable.ClearTable();
+        BestMoveSearch searcher{bd, *stack, 0, nullptr, 1, rootTables.get()};
+        searcher.QuiesceEval();
+
+        EXPECT_GT(rootCache.GetProbes(), 0);
+        EXPECT_EQ(rootCache.GetHits() == rootCache.GetProbes(), isWarm);
+    }
+    GameTimeManager::StopSearchManagement();
+
+    Board evalBd = bd;
+    int cachedEval{};
+    ASSERT_TRUE(rootCache.Probe(bd.ZobristKey, cachedEval));
+    EXPECT_EQ(cachedEval, BoardEvaluator::DefaultFullEvalFunction(evalBd, evalBd.MovingColor));
+
+    TTable.ClearTable();
+}
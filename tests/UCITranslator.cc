@@ -100,6 +100,51 @@ TEST(GoCommandTest, timeSpentTest)
     ASSERT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count(), 1200 * 1.1);
 }
 
+TEST(GoCommandTest, deadlineOvershoot)
+{
+    GameTimeManager::StartTimerAsync();
+    SearchThreadManager threadManager{};
+    Board board = FenTranslator::GetDefault();
+
+    GoInfo info{};
+    info.timeInfo.moveTime = 300;
+    ASSERT_TRUE(threadManager.Go(board, info));
+
+    while (threadManager.IsSearchOn()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    // search stopped by the deadline should finish shortly after it
+    const lli overshootUs = GameTimeManager::GetDeadlineOvershootUs();
+    ASSERT_GE(overshootUs, 0);
+    ASSERT_LT(overshootUs, 100 * 1000);
+}
+
+TEST(GoCommandTest, multiThreadedSearch)
+{
+    GameTimeManager::StartTimerAsync();
+    SearchThreadManager threadManager{};
+    Board board = FenTranslator::GetDefault();
+
+    ASSERT_TRUE(threadManager.SetThreadCount(4));
+    ASSERT_EQ(threadManager.GetThreadCount(), 4);
+
+    GoInfo info{};
+    info.depth = 7;
+    ASSERT_TRUE(threadManager.Go(board, info));
+
+    // threads cannot be changed during the search
+    ASSERT_FALSE(threadManager.SetThreadCount(2));
+
+    const auto t1 = std::chrono::steady_clock::now();
+    while (threadManager.IsSearchOn())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ASSERT_LT(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - t1).count(), 30);
+    }
+
+    ASSERT_TRUE(threadManager.SetThreadCount(1));
+    ASSERT_EQ(threadManager.GetThreadCount(), 1);
+}
+
 TEST(Aging, EngineAging)
 {
     TestSetup setup{};